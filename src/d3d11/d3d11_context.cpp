@@ -56,15 +56,13 @@ namespace dxvk {
       if (m_parent->GetOptions()->maxTessFactor > 0)
         maxTessFactor = std::min(maxTessFactor, m_parent->GetOptions()->maxTessFactor);
 
-      EmitCs([
-        cMaxTessFactor = maxTessFactor
-      ] (DxvkContext* ctx) {
-        D3D11HsPushData pushData = {};
-        pushData.maxTessFactor = float(cMaxTessFactor);
+      DxvkCsPushData<D3D11HsPushData> pushData = { };
+      pushData.header.stages = VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+      pushData.header.offset = 0u;
+      pushData.header.size = sizeof(pushData.data);
+      pushData.data.maxTessFactor = float(maxTessFactor);
 
-        ctx->pushData(VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT,
-          0, sizeof(pushData), &pushData);
-      });
+      EmitCs(pushData);
     }
   }
 
@@ -3380,13 +3378,9 @@ namespace dxvk {
 
   template<typename ContextType>
   void D3D11CommonContext<ContextType>::ApplyBlendFactor() {
-    EmitCs([
-      cBlendConstants = DxvkBlendConstants {
-        m_state.om.blendFactor[0], m_state.om.blendFactor[1],
-        m_state.om.blendFactor[2], m_state.om.blendFactor[3] }
-    ] (DxvkContext* ctx) {
-      ctx->setBlendConstants(cBlendConstants);
-    });
+    EmitCs(DxvkCsSetBlendConstants { DxvkBlendConstants {
+      m_state.om.blendFactor[0], m_state.om.blendFactor[1],
+      m_state.om.blendFactor[2], m_state.om.blendFactor[3] } });
   }
 
 
@@ -3408,11 +3402,7 @@ namespace dxvk {
   
   template<typename ContextType>
   void D3D11CommonContext<ContextType>::ApplyStencilRef() {
-    EmitCs([
-      cStencilRef = m_state.om.stencilRef
-    ] (DxvkContext* ctx) {
-      ctx->setStencilReference(cStencilRef);
-    });
+    EmitCs(DxvkCsSetStencilReference { m_state.om.stencilRef });
   }
   
   
@@ -5804,6 +5794,14 @@ namespace dxvk {
         }
       }
 
+      // On the immediate context, try to write large updates to
+      // the mapped buffer directly before falling back to a copy
+      if constexpr (!IsDeferred) {
+        if (bufferResource->GetMapMode() == D3D11_COMMON_BUFFER_MAP_MODE_DIRECT
+         && context->UpdateMappedBufferRange(bufferResource, offset, length, pSrcData))
+          return;
+      }
+
       // Otherwise we can't really do anything fancy, so just do a GPU copy
       if (likely(length))
         context->UpdateBuffer(bufferResource, offset, length, pSrcData);
@@ -18,7 +18,7 @@ namespace dxvk {
   : D3D11CommonContext<D3D11ImmediateContext>(pParent, Device, 0, DxvkCsChunkFlag::SingleUse),
     m_csThread(Device, Device->createContext()),
     m_submissionFence(new sync::CallbackFence()),
-    m_flushTracker(GetMaxFlushType(pParent, Device)),
+    m_flushTracker(GetMaxFlushType(pParent, Device), GetFlushMode(pParent, Device)),
     m_stagingBufferFence(new sync::Fence(0)),
     m_multithread(this, false, pParent->GetOptions()->enableContextLock),
     m_videoContext(this, Device),
@@ -763,6 +763,76 @@ namespace dxvk {
   }
 
 
+  bool D3D11ImmediateContext::UpdateMappedBufferRange(
+          D3D11Buffer*                  pDstBuffer,
+          UINT                          Offset,
+          UINT                          Length,
+    const void*                         pSrcData) {
+    // Small updates are cheap enough to go through the staging buffer,
+    // and aren't worth potentially synchronizing with the CS thread.
+    constexpr UINT MinMappedUpdateSize = 4096u;
+
+    if (Length < MinMappedUpdateSize)
+      return false;
+
+    // Renaming the buffer requires reading back its current contents,
+    // which is only safe if there are no pending GPU writes, and
+    // uncached reads may well be slower than a staging copy.
+    auto buffer = pDstBuffer->GetBuffer();
+
+    VkDeviceSize bufferSize = pDstBuffer->Desc()->ByteWidth;
+
+    bool canRename = bufferSize <= D3D11Initializer::MaxMemoryPerSubmission
+      && (buffer->memFlags() & VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+
+    // Synchronizing with the CS thread cannot make a buffer idle that
+    // is already in use on the GPU, so don't bother in that case.
+    if (buffer->isInUse(canRename ? DxvkAccess::Write : DxvkAccess::Read))
+      return false;
+
+    // Buffers that can be bound to the pipeline do not track sequence
+    // numbers and would require a full CS thread synchronization. Only
+    // do that if the CS thread has already processed all prior chunks,
+    // so that we at most wait for the current one to execute.
+    auto sequenceNumber = pDstBuffer->GetSequenceNumber();
+
+    if (sequenceNumber == DxvkCsThread::SynchronizeAll
+     && m_csThread.lastSequenceNumber() < m_csSeqNum)
+      return false;
+
+    SynchronizeCsThread(sequenceNumber);
+
+    if (!buffer->isInUse(DxvkAccess::Read)) {
+      std::memcpy(reinterpret_cast<char*>(pDstBuffer->GetMapPtr()) + Offset, pSrcData, Length);
+      return true;
+    }
+
+    // The buffer is in use, so rename it and preserve
+    // the remaining contents on the CPU if possible.
+    if (!canRename || buffer->isInUse(DxvkAccess::Write))
+      return false;
+
+    auto srcPtr = reinterpret_cast<const char*>(pDstBuffer->GetMapPtr());
+
+    auto dstSlice = pDstBuffer->DiscardSlice(nullptr);
+    auto dstPtr = reinterpret_cast<char*>(dstSlice->mapPtr());
+
+    EmitCs([
+      cBuffer      = std::move(buffer),
+      cBufferSlice = std::move(dstSlice)
+    ] (DxvkContext* ctx) mutable {
+      ctx->invalidateBuffer(cBuffer, std::move(cBufferSlice));
+    });
+
+    std::memcpy(dstPtr, srcPtr, Offset);
+    std::memcpy(dstPtr + Offset, pSrcData, Length);
+    std::memcpy(dstPtr + Offset + Length, srcPtr + Offset + Length, bufferSize - Offset - Length);
+
+    ThrottleDiscard(bufferSize);
+    return true;
+  }
+
+
   void STDMETHODCALLTYPE D3D11ImmediateContext::SwapDeviceContextState(
           ID3DDeviceContextState*           pState,
           ID3DDeviceContextState**          ppPreviousState) {
@@ -1137,6 +1207,17 @@ namespace dxvk {
     m_flushSeqNum = m_csSeqNum;
     m_flushTracker.notifyFlush(m_flushSeqNum, submissionId);
 
+    if (m_flushTracker.needsFeedback()) {
+      DxvkSubmissionStats stats = m_device->getSubmissionStats();
+
+      GpuFlushFeedback feedback;
+      feedback.gpuIdleTicks = stats.gpuIdleTicks;
+      feedback.submissionCount = stats.submissionCount;
+      feedback.submissionTicks = stats.submissionTicks;
+
+      m_flushTracker.notifyFeedback(feedback);
+    }
+
     // If necessary, block calling thread until the
     // Vulkan queue submission is performed.
     if (synchronizeSubmission)
@@ -1248,4 +1329,15 @@ namespace dxvk {
       return GpuFlushType::ImplicitWeakHint;
   }
 
+
+  GpuFlushMode D3D11ImmediateContext::GetFlushMode(
+          D3D11Device*    pParent,
+    const Rc<DxvkDevice>& Device) {
+    // Measured feedback would make the command stream timing-dependent
+    if (pParent->GetOptions()->reproducibleCommandStream)
+      return GpuFlushMode::Static;
+
+    return Device->config().flushMode;
+  }
+
 }
@@ -175,6 +175,12 @@ namespace dxvk {
       const void*                       pSrcData,
             UINT                        CopyFlags);
 
+    bool UpdateMappedBufferRange(
+            D3D11Buffer*                pDstBuffer,
+            UINT                        Offset,
+            UINT                        Length,
+      const void*                       pSrcData);
+
     void SynchronizeDevice();
 
     void EndFrame(
@@ -229,6 +235,10 @@ namespace dxvk {
             D3D11Device*    pParent,
       const Rc<DxvkDevice>& Device);
 
+    static GpuFlushMode GetFlushMode(
+            D3D11Device*    pParent,
+      const Rc<DxvkDevice>& Device);
+
   };
   
 }
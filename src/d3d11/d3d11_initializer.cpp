@@ -193,8 +193,6 @@ namespace dxvk {
             VkDeviceSize mipSizePerLayer = util::computeImageDataSize(
               packedFormat, image->mipLevelExtent(mip), formatInfo->aspectMask);
 
-            m_transferCommands += 1;
-
             util::packImageData(stagingSlice.mapPtr(dataOffset),
               pInitialData[index].pSysMem, pInitialData[index].SysMemPitch, pInitialData[index].SysMemSlicePitch,
               0, 0, pTexture->GetVkImageType(), mipLevelExtent, 1, formatInfo, formatInfo->aspectMask);
@@ -210,8 +208,21 @@ namespace dxvk {
         }
       }
 
-      // Upload all subresources of the image in one go
+      // Upload all subresources of the image in one go. For most images,
+      // this is a single batch of copies on the transfer queue that the
+      // graphics queue only waits for on first use, so count it once.
+      // Depth-stencil and multisampled images are instead initialized on
+      // the graphics queue one subresource at a time, count those fully.
       if (pTexture->HasImage()) {
+        constexpr VkImageAspectFlags DsAspects = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+
+        bool uploadPerSubresource = image->info().sampleCount != VK_SAMPLE_COUNT_1_BIT
+          || ((image->formatInfo()->aspectMask | formatInfo->aspectMask) & DsAspects);
+
+        m_transferCommands += uploadPerSubresource
+          ? image->info().mipLevels * image->info().numLayers
+          : 1u;
+
         EmitCs([
           cImage        = std::move(image),
           cStagingSlice = std::move(stagingSlice),
@@ -24,7 +24,8 @@ namespace dxvk {
     constexpr static VkDeviceSize StagingBufferSize = 1ull << 20;
   public:
 
-    // Maximum number of copy and clear commands to record before flushing
+    // Maximum number of copy and clear commands to record before flushing.
+    // Uploads that go through the transfer queue count once per resource.
     constexpr static size_t MaxCommandsPerSubmission = 512u;
 
     // Maximum amount of staging memory to allocate before flushing
@@ -126,6 +126,7 @@ namespace dxvk {
     DXGI_VK_FRAME_STATISTICS  m_frameStatistics = { };
 
     Rc<hud::HudLatencyItem>   m_latencyHud;
+    Rc<hud::HudFramePacingItem> m_pacingHud;
 
     Rc<DxvkImageView> GetBackBufferView();
 
@@ -3,6 +3,7 @@
 #include "d3d11_context_imm.h"
 #include "d3d11_video.h"
 
+#include <d3d11_video_blit_comp.h>
 #include <d3d11_video_blit_frag.h>
 #include <d3d11_video_blit_vert.h>
 
@@ -1215,55 +1216,61 @@ namespace dxvk {
     auto& outputView = static_cast<D3D11VideoProcessorOutputView*>(pOutputView)->GetCommon();
     auto views = outputView.GetViews();
 
-    bool hasStreamsEnabled = false;
+    // Composite all streams in a single compute dispatch where possible,
+    // otherwise fall back to rendering each stream and plane separately.
+    if (CanUseComputeBlit(outputView, videoProcessor, StreamCount, pStreams)) {
+      BlitStreamsCompute(outputView, videoProcessor, StreamCount, pStreams);
+    } else {
+      bool hasStreamsEnabled = false;
 
-    m_dstIsYCbCr = outputView.IsYCbCr();
+      m_dstIsYCbCr = outputView.IsYCbCr();
 
-    for (uint32_t vi = 0; vi < views.size(); vi++) {
-      if (!views[vi])
-        continue;
+      for (uint32_t vi = 0; vi < views.size(); vi++) {
+        if (!views[vi])
+          continue;
 
-      bool outputBound = false;
+        bool outputBound = false;
 
-      // Resetting and restoring all context state incurs
-      // a lot of overhead, so only do it as necessary
-      for (uint32_t i = 0; i < StreamCount; i++) {
-        auto streamState = videoProcessor->GetStreamState(i);
+        // Resetting and restoring all context state incurs
+        // a lot of overhead, so only do it as necessary
+        for (uint32_t i = 0; i < StreamCount; i++) {
+          auto streamState = videoProcessor->GetStreamState(i);
 
-        if (!pStreams[i].Enable || !streamState)
-          continue;
+          if (!pStreams[i].Enable || !streamState)
+            continue;
 
-        if (!hasStreamsEnabled) {
-          m_ctx->ResetDirtyTracking();
-          m_ctx->ResetCommandListState();
+          if (!hasStreamsEnabled) {
+            m_ctx->ResetDirtyTracking();
+            m_ctx->ResetCommandListState();
 
-          CopyBaseImageToShadow(outputView);
+            CopyBaseImageToShadow(outputView);
 
-          hasStreamsEnabled = true;
-        }
+            hasStreamsEnabled = true;
+          }
 
-        if (!outputBound) {
-          BindOutputView(views[vi], views[0]);
-          outputBound = true;
-        }
+          if (!outputBound) {
+            BindOutputView(views[vi], views[0]);
+            outputBound = true;
+          }
 
-        if (!views[1])
-          m_exportMode = ExportRGBA;
-        else if (!vi)
-          m_exportMode = ExportY;
-        else
-          m_exportMode = ExportCbCr;
+          if (!views[1])
+            m_exportMode = ExportRGBA;
+          else if (!vi)
+            m_exportMode = ExportY;
+          else
+            m_exportMode = ExportCbCr;
 
-        BlitStream(streamState, &pStreams[i]);
+          BlitStream(streamState, &pStreams[i]);
+        }
       }
-    }
 
-    if (hasStreamsEnabled) {
-      CopyShadowToBaseImage(outputView);
+      if (hasStreamsEnabled) {
+        CopyShadowToBaseImage(outputView);
 
-      UnbindResources();
+        UnbindResources();
 
-      m_ctx->RestoreCommandListState();
+        m_ctx->RestoreCommandListState();
+      }
     }
 
     m_ctx->EmitCs([] (DxvkContext* ctx) {
@@ -1434,15 +1441,7 @@ namespace dxvk {
     const D3D11VideoProcessorStreamState* pStreamState,
     const D3D11_VIDEO_PROCESSOR_STREAM*   pStream) {
     CreateResources();
-
-    if (pStream->PastFrames || pStream->FutureFrames)
-      Logger::err("D3D11VideoContext: Ignoring non-zero PastFrames and FutureFrames");
-
-    if (pStream->OutputIndex)
-      Logger::err("D3D11VideoContext: Ignoring non-zero OutputIndex");
-
-    if (pStream->InputFrameOrField)
-      Logger::err("D3D11VideoContext: Ignoring non-zero InputFrameOrField");
+    ValidateStream(pStream);
 
     auto& view = static_cast<D3D11VideoProcessorInputView*>(pStream->pInputSurface)->GetCommon();
 
@@ -1548,6 +1547,212 @@ namespace dxvk {
   }
 
 
+  bool D3D11VideoContext::CanUseComputeBlit(
+    const D3D11VideoProcessorView&        OutputView,
+          D3D11VideoProcessor*            pVideoProcessor,
+          UINT                            StreamCount,
+    const D3D11_VIDEO_PROCESSOR_STREAM*   pStreams) {
+    auto views = OutputView.GetViews();
+
+    // Planar outputs would need storage views for each plane, and
+    // if a shadow image is required there is nothing to gain here
+    if (views[1] || OutputView.GetShadow())
+      return false;
+
+    Rc<DxvkImage> image = OutputView.GetImage();
+
+    if (image->info().shared && !(image->info().usage & VK_IMAGE_USAGE_STORAGE_BIT))
+      return false;
+
+    auto formatFeatures = m_device->getFormatFeatures(views[0]->info().format);
+
+    if (!(formatFeatures.optimal & VK_FORMAT_FEATURE_2_STORAGE_IMAGE_BIT)
+     || !(formatFeatures.optimal & VK_FORMAT_FEATURE_2_STORAGE_WRITE_WITHOUT_FORMAT_BIT))
+      return false;
+
+    for (uint32_t i = 0; i < StreamCount; i++) {
+      if (!pStreams[i].Enable || !pVideoProcessor->GetStreamState(i))
+        continue;
+
+      auto& view = static_cast<D3D11VideoProcessorInputView*>(pStreams[i].pInputSurface)->GetCommon();
+
+      if (view.GetShadow())
+        return false;
+    }
+
+    return true;
+  }
+
+
+  void D3D11VideoContext::BlitStreamsCompute(
+    const D3D11VideoProcessorView&        OutputView,
+          D3D11VideoProcessor*            pVideoProcessor,
+          UINT                            StreamCount,
+    const D3D11_VIDEO_PROCESSOR_STREAM*   pStreams) {
+    std::array<Rc<DxvkImage>, D3D11_VK_VIDEO_STREAM_COUNT> inputImages;
+    std::array<InputViews, D3D11_VK_VIDEO_STREAM_COUNT> inputViews;
+
+    auto outputViews = OutputView.GetViews();
+
+    VkExtent3D dstExtent = outputViews[0]->mipLevelExtent(0);
+
+    CsUboData uboData = { };
+
+    for (uint32_t i = 0; i < StreamCount; i++) {
+      auto streamState = pVideoProcessor->GetStreamState(i);
+
+      if (!pStreams[i].Enable || !streamState)
+        continue;
+
+      ValidateStream(&pStreams[i]);
+
+      auto& view = static_cast<D3D11VideoProcessorInputView*>(pStreams[i].pInputSurface)->GetCommon();
+
+      uint32_t index = uboData.streamCount++;
+      inputImages[index] = view.GetImage();
+      inputViews[index] = view.GetViews();
+
+      FillComputeStreamData(&uboData.streams[index], streamState, view,
+        VkExtent2D { dstExtent.width, dstExtent.height }, OutputView.IsYCbCr());
+    }
+
+    if (!uboData.streamCount)
+      return;
+
+    CreateResources();
+
+    m_ctx->ResetDirtyTracking();
+    m_ctx->ResetCommandListState();
+
+    // All enabled streams are converted and composited in a single
+    // dispatch, which writes the output image directly.
+    m_ctx->EmitCs([this,
+      cOutputImage  = OutputView.GetImage(),
+      cOutputView   = outputViews[0],
+      cInputImages  = std::move(inputImages),
+      cInputViews   = std::move(inputViews),
+      cUboData      = uboData,
+      cDstExtent    = dstExtent
+    ] (DxvkContext* ctx) {
+      DxvkImageUsageInfo dstUsage = { };
+      dstUsage.usage = VK_IMAGE_USAGE_STORAGE_BIT;
+      dstUsage.stages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+      dstUsage.access = VK_ACCESS_SHADER_WRITE_BIT;
+
+      if (!ctx->ensureImageCompatibility(cOutputImage, dstUsage)) {
+        Logger::err("D3D11VideoContext: Failed to make output image compatible with storage usage");
+        return;
+      }
+
+      DxvkImageUsageInfo srcUsage = { };
+      srcUsage.usage = VK_IMAGE_USAGE_SAMPLED_BIT;
+      srcUsage.stages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+      srcUsage.access = VK_ACCESS_SHADER_READ_BIT;
+
+      for (uint32_t i = 0; i < cUboData.streamCount; i++)
+        ctx->ensureImageCompatibility(cInputImages[i], srcUsage);
+
+      DxvkImageViewKey viewKey = cOutputView->info();
+      viewKey.usage = VK_IMAGE_USAGE_STORAGE_BIT;
+      viewKey.layout = VK_IMAGE_LAYOUT_GENERAL;
+
+      Rc<DxvkResourceAllocation> uboSlice = m_csUbo->allocateStorage();
+      memcpy(uboSlice->mapPtr(), &cUboData, sizeof(cUboData));
+
+      ctx->invalidateBuffer(m_csUbo, std::move(uboSlice));
+
+      ctx->bindShader<VK_SHADER_STAGE_COMPUTE_BIT>(Rc<DxvkShader>(m_cs));
+      ctx->bindUniformBuffer(VK_SHADER_STAGE_COMPUTE_BIT, 0, DxvkBufferSlice(m_csUbo));
+      ctx->bindResourceImageView(VK_SHADER_STAGE_COMPUTE_BIT, 1, cOutputImage->createView(viewKey));
+
+      for (uint32_t i = 0; i < cUboData.streamCount; i++) {
+        for (uint32_t j = 0; j < cInputViews[i].size(); j++)
+          ctx->bindResourceImageView(VK_SHADER_STAGE_COMPUTE_BIT, 2 + 2 * i + j, Rc<DxvkImageView>(cInputViews[i][j]));
+      }
+
+      ctx->dispatch(
+        (cDstExtent.width  + 7u) / 8u,
+        (cDstExtent.height + 7u) / 8u, 1u);
+
+      for (uint32_t i = 0; i < 1u + 2u * cUboData.streamCount; i++)
+        ctx->bindResourceImageView(VK_SHADER_STAGE_COMPUTE_BIT, 1 + i, nullptr);
+
+      ctx->bindShader<VK_SHADER_STAGE_COMPUTE_BIT>(nullptr);
+      ctx->bindUniformBuffer(VK_SHADER_STAGE_COMPUTE_BIT, 0, DxvkBufferSlice());
+    });
+
+    m_ctx->RestoreCommandListState();
+  }
+
+
+  void D3D11VideoContext::FillComputeStreamData(
+          CsStreamData*                   pData,
+    const D3D11VideoProcessorStreamState* pStreamState,
+    const D3D11VideoProcessorView&        InputView,
+          VkExtent2D                      DstExtent,
+          bool                            DstIsYCbCr) {
+    auto views = InputView.GetViews();
+
+    VkExtent3D viewExtent = views[0]->mipLevelExtent(0);
+
+    VkRect2D srcRect;
+    srcRect.offset = { 0, 0 };
+    srcRect.extent = { viewExtent.width, viewExtent.height };
+
+    if (pStreamState->srcRectEnabled) {
+      srcRect.offset.x      = pStreamState->srcRect.left;
+      srcRect.offset.y      = pStreamState->srcRect.top;
+      srcRect.extent.width  = pStreamState->srcRect.right - srcRect.offset.x;
+      srcRect.extent.height = pStreamState->srcRect.bottom - srcRect.offset.y;
+    }
+
+    pData->dstOffset[0] = 0.0f;
+    pData->dstOffset[1] = 0.0f;
+    pData->dstExtent[0] = float(DstExtent.width);
+    pData->dstExtent[1] = float(DstExtent.height);
+
+    if (pStreamState->dstRectEnabled) {
+      pData->dstOffset[0] = float(pStreamState->dstRect.left);
+      pData->dstOffset[1] = float(pStreamState->dstRect.top);
+      pData->dstExtent[0] = float(pStreamState->dstRect.right) - pData->dstOffset[0];
+      pData->dstExtent[1] = float(pStreamState->dstRect.bottom) - pData->dstOffset[1];
+    }
+
+    pData->colorMatrix[0][0] = 1.0f;
+    pData->colorMatrix[1][1] = 1.0f;
+    pData->colorMatrix[2][2] = 1.0f;
+    pData->coordMatrix[0][0] = float(srcRect.extent.width) / float(viewExtent.width);
+    pData->coordMatrix[1][1] = float(srcRect.extent.height) / float(viewExtent.height);
+    pData->coordMatrix[2][0] = float(srcRect.offset.x) / float(viewExtent.width);
+    pData->coordMatrix[2][1] = float(srcRect.offset.y) / float(viewExtent.height);
+    pData->srcRect = srcRect;
+    pData->yMin = 0.0f;
+    pData->yMax = 1.0f;
+    pData->isPlanar = views[1] != nullptr;
+
+    if (InputView.IsYCbCr() && !DstIsYCbCr)
+      ApplyYCbCrMatrix(pData->colorMatrix, pStreamState->colorSpace.YCbCr_Matrix);
+
+    if (pStreamState->colorSpace.Nominal_Range) {
+      pData->yMin = 0.0627451f;
+      pData->yMax = 0.9215686f;
+    }
+  }
+
+
+  void D3D11VideoContext::ValidateStream(
+    const D3D11_VIDEO_PROCESSOR_STREAM*   pStream) {
+    if (pStream->PastFrames || pStream->FutureFrames)
+      Logger::err("D3D11VideoContext: Ignoring non-zero PastFrames and FutureFrames");
+
+    if (pStream->OutputIndex)
+      Logger::err("D3D11VideoContext: Ignoring non-zero OutputIndex");
+
+    if (pStream->InputFrameOrField)
+      Logger::err("D3D11VideoContext: Ignoring non-zero InputFrameOrField");
+  }
+
+
   void D3D11VideoContext::CopyBaseImageToShadow(
     const D3D11VideoProcessorView&        View) {
     auto shadow = View.GetShadow();
@@ -1591,6 +1796,12 @@ namespace dxvk {
     bufferInfo.debugName = "Video blit parameters";
 
     m_ubo = m_device->createBuffer(bufferInfo, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    bufferInfo.size = sizeof(CsUboData);
+    bufferInfo.stages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    bufferInfo.debugName = "Video blit parameters (compute)";
+
+    m_csUbo = m_device->createBuffer(bufferInfo, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
   }
 
 
@@ -1608,6 +1819,18 @@ namespace dxvk {
     fsInfo.bindingCount = fsBindings.size();
     fsInfo.bindings = fsBindings.data();
     m_fs = new DxvkSpirvShader(fsInfo, d3d11_video_blit_frag);
+
+    std::array<DxvkBindingInfo, 2u + 2u * D3D11_VK_VIDEO_STREAM_COUNT> csBindings = { };
+    csBindings[0] = { 0u, 0u, 0u, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1u, VK_IMAGE_VIEW_TYPE_MAX_ENUM, VK_ACCESS_UNIFORM_READ_BIT, DxvkDescriptorFlag::UniformBuffer };
+    csBindings[1] = { 0u, 1u, 1u, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,  1u, VK_IMAGE_VIEW_TYPE_2D,       VK_ACCESS_SHADER_WRITE_BIT };
+
+    for (uint32_t i = 2u; i < csBindings.size(); i++)
+      csBindings[i] = { 0u, i, i, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1u, VK_IMAGE_VIEW_TYPE_2D, VK_ACCESS_SHADER_READ_BIT };
+
+    DxvkSpirvShaderCreateInfo csInfo = { };
+    csInfo.bindingCount = csBindings.size();
+    csInfo.bindings = csBindings.data();
+    m_cs = new DxvkSpirvShader(csInfo, d3d11_video_blit_comp);
   }
 
 
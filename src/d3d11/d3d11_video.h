@@ -663,12 +663,33 @@ namespace dxvk {
       ExportMode exportMode;
     };
 
+    struct alignas(16) CsStreamData {
+      float colorMatrix[3][4];
+      float coordMatrix[3][2];
+      VkRect2D srcRect;
+      float dstOffset[2];
+      float dstExtent[2];
+      float yMin, yMax;
+      VkBool32 isPlanar;
+      uint32_t reserved;
+    };
+
+    struct alignas(16) CsUboData {
+      uint32_t streamCount;
+      uint32_t reserved[3];
+      CsStreamData streams[D3D11_VK_VIDEO_STREAM_COUNT];
+    };
+
+    using InputViews = std::array<Rc<DxvkImageView>, 2>;
+
     D3D11ImmediateContext*  m_ctx;
 
     Rc<DxvkDevice>          m_device;
     Rc<DxvkShader>          m_vs;
     Rc<DxvkShader>          m_fs;
+    Rc<DxvkShader>          m_cs;
     Rc<DxvkBuffer>          m_ubo;
+    Rc<DxvkBuffer>          m_csUbo;
 
     VkExtent2D m_dstExtent      = { 0u, 0u };
     float      m_dstSizeFact[2] = { 1.0f, 1.0f };
@@ -689,6 +710,28 @@ namespace dxvk {
       const D3D11VideoProcessorStreamState* pStreamState,
       const D3D11_VIDEO_PROCESSOR_STREAM*   pStream);
 
+    bool CanUseComputeBlit(
+      const D3D11VideoProcessorView&        OutputView,
+            D3D11VideoProcessor*            pVideoProcessor,
+            UINT                            StreamCount,
+      const D3D11_VIDEO_PROCESSOR_STREAM*   pStreams);
+
+    void BlitStreamsCompute(
+      const D3D11VideoProcessorView&        OutputView,
+            D3D11VideoProcessor*            pVideoProcessor,
+            UINT                            StreamCount,
+      const D3D11_VIDEO_PROCESSOR_STREAM*   pStreams);
+
+    void FillComputeStreamData(
+            CsStreamData*                   pData,
+      const D3D11VideoProcessorStreamState* pStreamState,
+      const D3D11VideoProcessorView&        InputView,
+            VkExtent2D                      DstExtent,
+            bool                            DstIsYCbCr);
+
+    void ValidateStream(
+      const D3D11_VIDEO_PROCESSOR_STREAM*   pStream);
+
     void CopyBaseImageToShadow(
       const D3D11VideoProcessorView&        View);
 
@@ -57,7 +57,7 @@ namespace dxvk {
     , m_csThread           ( dxvkDevice, dxvkDevice->createContext() )
     , m_csChunk            ( AllocCsChunk() )
     , m_submissionFence    ( new sync::Fence() )
-    , m_flushTracker       ( GetMaxFlushType() )
+    , m_flushTracker       ( GetMaxFlushType(), GetFlushMode() )
     , m_d3d9Interop        ( this )
     , m_d3d9On12Args       ( pAdapter->Get9On12Args() )
     , m_d3d9On12           ( this )
@@ -5401,13 +5401,41 @@ namespace dxvk {
       VkExtent3D srcBlockCount = util::computeBlockCount(srcTexLevelExtent, srcBlockSize);
       srcBlockCount.height *= std::min(pSrcTexture->GetPlaneCount(), 2u);
 
-      // the converter can not handle the 4 aligned pitch so we always repack into a staging buffer
-      D3D9BufferSlice slice = AllocStagingBuffer(pSrcTexture->GetMipSize(SrcSubresource));
       VkDeviceSize pitch = align(srcBlockCount.width * formatElementSize, 4);
 
       const DxvkFormatInfo* convertedFormatInfo = lookupFormatInfo(convertFormat.Format);
       VkImageSubresourceLayers convertedDstLayers = { convertedFormatInfo->aspectMask, dstSubresource.mipLevel, dstSubresource.arrayLayer, 1 };
 
+      if (m_converter->ShouldConvertOnCpu(convertFormat, srcTexLevelExtent, pitch)) {
+        // Small uploads get converted straight into staging memory,
+        // which saves us the compute dispatch and barrier.
+        D3D9BufferSlice slice = AllocStagingBuffer(convertedFormatInfo->elementSize
+          * srcTexLevelExtent.width * srcTexLevelExtent.height);
+
+        m_converter->ConvertFormatCpu(convertFormat,
+          slice.mapPtr, mapPtr, pitch, srcTexLevelExtent);
+
+        EmitCs([
+          cSrcSlice       = std::move(slice.slice),
+          cDstImage       = std::move(image),
+          cDstLayers      = convertedDstLayers,
+          cDstLevelExtent = srcTexLevelExtent
+        ] (DxvkContext* ctx) {
+          ctx->copyBufferToImage(
+            cDstImage,  cDstLayers,
+            VkOffset3D { 0, 0, 0 }, cDstLevelExtent,
+            cSrcSlice.buffer(), cSrcSlice.offset(),
+            0, 0, VK_FORMAT_UNDEFINED);
+        });
+
+        UnmapTextures();
+        ConsiderFlush(GpuFlushType::ImplicitWeakHint);
+        return;
+      }
+
+      // the converter can not handle the 4 aligned pitch so we always repack into a staging buffer
+      D3D9BufferSlice slice = AllocStagingBuffer(pSrcTexture->GetMipSize(SrcSubresource));
+
       util::packImageData(
         slice.mapPtr, mapPtr, srcBlockCount, formatElementSize,
         pitch, std::min(pSrcTexture->GetPlaneCount(), 2u) * pitch * srcBlockCount.height);
@@ -6156,6 +6184,17 @@ namespace dxvk {
     m_flushSeqNum = m_csSeqNum;
     m_flushTracker.notifyFlush(m_flushSeqNum, submissionId);
 
+    if (m_flushTracker.needsFeedback()) {
+      DxvkSubmissionStats stats = m_dxvkDevice->getSubmissionStats();
+
+      GpuFlushFeedback feedback;
+      feedback.gpuIdleTicks = stats.gpuIdleTicks;
+      feedback.submissionCount = stats.submissionCount;
+      feedback.submissionTicks = stats.submissionTicks;
+
+      m_flushTracker.notifyFeedback(feedback);
+    }
+
     // If necessary, block calling thread until the
     // Vulkan queue submission is performed.
     if (Synchronize9On12)
@@ -6663,9 +6702,13 @@ namespace dxvk {
 
   template<typename T>
   void D3D9DeviceEx::UpdatePushDataBlock(const T& Block) {
-    EmitCs([cBlock = Block] (DxvkContext* ctx) {
-      ctx->pushData(T::Stages, T::Offset, sizeof(T), &cBlock);
-    });
+    DxvkCsPushData<T> pushData;
+    pushData.header.stages = T::Stages;
+    pushData.header.offset = T::Offset;
+    pushData.header.size = sizeof(T);
+    pushData.data = Block;
+
+    EmitCs(pushData);
   }
 
 
@@ -7028,11 +7071,7 @@ namespace dxvk {
       D3DCOLOR(m_state.renderStates[D3DRS_BLENDFACTOR]),
       reinterpret_cast<float*>(&blendConstants));
 
-    EmitCs([
-      cBlendConstants = blendConstants
-    ](DxvkContext* ctx) {
-      ctx->setBlendConstants(cBlendConstants);
-    });
+    EmitCs(DxvkCsSetBlendConstants { blendConstants });
   }
 
 
@@ -7121,11 +7160,7 @@ namespace dxvk {
     biases.depthBiasSlope    = slopeScaledDepthBias;
     biases.depthBiasClamp    = 0.0f;
 
-    EmitCs([
-      cBiases = biases
-    ](DxvkContext* ctx) {
-      ctx->setDepthBias(cBiases);
-    });
+    EmitCs(DxvkCsSetDepthBias { biases });
   }
 
 
@@ -7185,9 +7220,7 @@ namespace dxvk {
 
     uint32_t ref = uint32_t(rs[D3DRS_STENCILREF]) & 0xff;
 
-    EmitCs([cRef = ref] (DxvkContext* ctx) {
-      ctx->setStencilReference(cRef);
-    });
+    EmitCs(DxvkCsSetStencilReference { ref });
   }
 
 
@@ -9138,6 +9171,15 @@ namespace dxvk {
   }
 
 
+  GpuFlushMode D3D9DeviceEx::GetFlushMode() const {
+    // Measured feedback would make the command stream timing-dependent
+    if (m_d3d9Options.reproducibleCommandStream)
+      return GpuFlushMode::Static;
+
+    return m_dxvkDevice->config().flushMode;
+  }
+
+
   bool D3D9DeviceEx::ValidateSharedTexture(
     HANDLE                          handle,
     D3DRESOURCETYPE                 type,
@@ -1535,6 +1535,8 @@ namespace dxvk {
 
     GpuFlushType GetMaxFlushType() const;
 
+    GpuFlushMode GetFlushMode() const;
+
     bool ValidateSharedTexture(
       HANDLE                          handle,
       D3DRESOURCETYPE                 type,
@@ -8,12 +8,186 @@
 #include <d3d9_convert_nv12.h>
 #include <d3d9_convert_yv12.h>
 
+#include "../util/util_bit.h"
+#include "../util/util_time.h"
+
 namespace dxvk {
 
+  /**
+   * \brief YUV to RGB conversion coefficients
+   *
+   * Each row stores the Y, U, V and constant factors for one
+   * output channel. These must match d3d9_convert_common.h.
+   */
+  struct D3D9YuvCoefficients {
+    float r[4];
+    float g[4];
+    float b[4];
+  };
+
+  // convertYUV. Note that the shader computes the coefficients with
+  // integer division, the CPU path must produce identical results.
+  static const D3D9YuvCoefficients g_yuvToRgb = {
+    { 1.0f, 0.0f, 1.0f, 0.5f / 255.0f },
+    { 1.0f, 0.0f, 0.0f, 0.5f / 255.0f },
+    { 1.0f, 2.0f, 0.0f, 0.5f / 255.0f },
+  };
+
+  // convertBT_709
+  static const D3D9YuvCoefficients g_bt709ToRgb = {
+    { 1.164f,  0.0f,    1.793f, 0.0f },
+    { 1.164f, -0.213f, -0.533f, 0.0f },
+    { 1.164f,  2.112f,  0.0f,   0.0f },
+  };
+
+
+  static uint16_t ConvertFloatToHalf(float f) {
+    uint32_t x = bit::cast<uint32_t>(f);
+    uint32_t sign = (x >> 16u) & 0x8000u;
+    uint32_t mant = x & 0x7fffffu;
+    int32_t  exp  = int32_t((x >> 23u) & 0xffu) - 127 + 15;
+
+    if (exp >= 31)
+      return sign | 0x7c00u;
+
+    uint32_t shift = 13u;
+
+    if (exp <= 0) {
+      if (exp < -10)
+        return sign;
+
+      // Denormal, include the implicit leading one
+      mant |= 0x800000u;
+      shift = uint32_t(14 - exp);
+      exp = 0;
+    }
+
+    uint32_t half = (uint32_t(exp) << 10u) | (mant >> shift);
+    uint32_t rem  = mant & ((1u << shift) - 1u);
+    uint32_t mid  = 1u << (shift - 1u);
+
+    // Round to nearest even
+    if (rem > mid || (rem == mid && (half & 1u)))
+      half += 1u;
+
+    return uint16_t(sign | half);
+  }
+
+
+  static float Unormalize(uint32_t value, uint32_t bits) {
+    return float(value) / float((1u << bits) - 1u);
+  }
+
+
+  static float Snormalize(int32_t value, uint32_t bits) {
+    return std::max(float(value) / float((1 << (bits - 1u)) - 1), -1.0f);
+  }
+
+
+  static int32_t SignExtend(uint32_t value, uint32_t bits) {
+    return int32_t(value << (32u - bits)) >> (32u - bits);
+  }
+
+
+  static int16_t ConvertFloatToSnorm16(float f) {
+    return int16_t(std::lrint(std::clamp(f, -1.0f, 1.0f) * 32767.0f));
+  }
+
+
+  static uint32_t ConvertYuvPixel(
+    const D3D9YuvCoefficients&          m,
+          uint8_t                       y,
+          uint8_t                       u,
+          uint8_t                       v) {
+    float fy = float(y) / 255.0f - 16.0f / 255.0f;
+    float fu = float(u) / 255.0f - 128.0f / 255.0f;
+    float fv = float(v) / 255.0f - 128.0f / 255.0f;
+
+    auto channel = [fy, fu, fv] (const float* k) {
+      float c = ((k[0] * fy + k[1] * fu) + k[2] * fv) + k[3];
+      return uint32_t(std::lrint(std::clamp(c, 0.0f, 1.0f) * 255.0f));
+    };
+
+    return channel(m.b) | (channel(m.g) << 8u) | (channel(m.r) << 16u) | 0xff000000u;
+  }
+
+
+#ifdef DXVK_ARCH_X86
+  static __m128 LoadYuvSse(const uint8_t* src, float bias) {
+    uint32_t packed;
+    std::memcpy(&packed, src, sizeof(packed));
+
+    __m128i zero = _mm_setzero_si128();
+    __m128i data = _mm_cvtsi32_si128(int32_t(packed));
+    data = _mm_unpacklo_epi8(data, zero);
+    data = _mm_unpacklo_epi16(data, zero);
+
+    return _mm_sub_ps(
+      _mm_div_ps(_mm_cvtepi32_ps(data), _mm_set1_ps(255.0f)),
+      _mm_set1_ps(bias));
+  }
+
+
+  static __m128i ConvertYuvChannelSse(const float* k, __m128 y, __m128 u, __m128 v) {
+    __m128 c = _mm_add_ps(
+      _mm_add_ps(
+        _mm_add_ps(
+          _mm_mul_ps(_mm_set1_ps(k[0]), y),
+          _mm_mul_ps(_mm_set1_ps(k[1]), u)),
+        _mm_mul_ps(_mm_set1_ps(k[2]), v)),
+      _mm_set1_ps(k[3]));
+
+    c = _mm_min_ps(_mm_max_ps(c, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    return _mm_cvtps_epi32(_mm_mul_ps(c, _mm_set1_ps(255.0f)));
+  }
+#endif
+
+
+  /**
+   * \brief Converts a run of YUV pixels to BGRA8
+   *
+   * Takes one Y, U and V sample per pixel.
+   */
+  static void ConvertYuvRun(
+    const D3D9YuvCoefficients&          m,
+          uint32_t                      count,
+          uint32_t*                     dst,
+    const uint8_t*                      y,
+    const uint8_t*                      u,
+    const uint8_t*                      v) {
+    uint32_t i = 0u;
+
+#ifdef DXVK_ARCH_X86
+    for ( ; i + 4u <= count; i += 4u) {
+      __m128 fy = LoadYuvSse(&y[i],  16.0f / 255.0f);
+      __m128 fu = LoadYuvSse(&u[i], 128.0f / 255.0f);
+      __m128 fv = LoadYuvSse(&v[i], 128.0f / 255.0f);
+
+      __m128i b = ConvertYuvChannelSse(m.b, fy, fu, fv);
+      __m128i g = ConvertYuvChannelSse(m.g, fy, fu, fv);
+      __m128i r = ConvertYuvChannelSse(m.r, fy, fu, fv);
+
+      __m128i bgra = _mm_or_si128(
+        _mm_or_si128(b, _mm_slli_epi32(g, 8)),
+        _mm_or_si128(_mm_slli_epi32(r, 16), _mm_set1_epi32(int32_t(0xff000000u))));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[i]), bgra);
+    }
+#endif
+
+    for ( ; i < count; i++)
+      dst[i] = ConvertYuvPixel(m, y[i], u[i], v[i]);
+  }
+
+
   D3D9FormatHelper::D3D9FormatHelper(const Rc<DxvkDevice>& device)
   : m_device          (device)
   , m_layout          (CreatePipelineLayout()) {
     InitPipelines();
+    InitLuts();
+
+    for (auto& ps : m_cpuPsPerPixel)
+      ps = InitCpuConversionPsPerPixel;
   }
 
 
@@ -68,6 +242,149 @@ namespace dxvk {
   }
 
 
+  bool D3D9FormatHelper::ShouldConvertOnCpu(
+          D3D9_CONVERSION_FORMAT_INFO   conversionFormat,
+          VkExtent3D                    extent,
+          VkDeviceSize                  srcPitch) const {
+    if (extent.depth != 1u)
+      return false;
+
+    switch (conversionFormat.FormatType) {
+      case D3D9ConversionFormat_YUY2:
+      case D3D9ConversionFormat_UYVY:
+        // The GPU path only writes full macro pixels
+        if (extent.width & 1u)
+          return false;
+        break;
+
+      case D3D9ConversionFormat_NV12:
+        if ((extent.width | extent.height) & 1u)
+          return false;
+        break;
+
+      case D3D9ConversionFormat_YV12:
+        // Chroma planes are addressed as if the data was tightly
+        // packed, which is only the case if there is no padding
+        if (((extent.width | extent.height) & 1u) || srcPitch != extent.width)
+          return false;
+        break;
+
+      case D3D9ConversionFormat_L6V5U5:
+      case D3D9ConversionFormat_X8L8V8U8:
+      case D3D9ConversionFormat_A2W10V10U10:
+      case D3D9ConversionFormat_W11V11U10:
+        break;
+
+      default:
+        return false;
+    }
+
+    uint64_t pixelCount = uint64_t(extent.width) * uint64_t(extent.height);
+    return pixelCount * m_cpuPsPerPixel[conversionFormat.FormatType] <= CpuConversionBudgetPs;
+  }
+
+
+  void D3D9FormatHelper::ConvertFormatCpu(
+          D3D9_CONVERSION_FORMAT_INFO   conversionFormat,
+          void*                         dstData,
+    const void*                         srcData,
+          VkDeviceSize                  srcPitch,
+          VkExtent3D                    extent) {
+    auto t0 = dxvk::high_resolution_clock::now();
+
+    auto srcBytes = reinterpret_cast<const uint8_t*>(srcData);
+
+    switch (conversionFormat.FormatType) {
+      case D3D9ConversionFormat_YUY2:
+      case D3D9ConversionFormat_UYVY:
+      case D3D9ConversionFormat_NV12:
+      case D3D9ConversionFormat_YV12: {
+        ConvertYuvCpu(conversionFormat.FormatType,
+          reinterpret_cast<uint32_t*>(dstData), srcBytes, srcPitch,
+          VkExtent2D { extent.width, extent.height });
+      } break;
+
+      case D3D9ConversionFormat_L6V5U5: {
+        auto dst = reinterpret_cast<uint16_t*>(dstData);
+
+        for (uint32_t y = 0; y < extent.height; y++) {
+          auto src = reinterpret_cast<const uint16_t*>(srcBytes + y * srcPitch);
+
+          for (uint32_t x = 0; x < extent.width; x++) {
+            uint32_t value = src[x];
+            *(dst++) = m_luts.snorm5[bit::extract(value, 0, 4)];
+            *(dst++) = m_luts.snorm5[bit::extract(value, 5, 9)];
+            *(dst++) = m_luts.unorm6[bit::extract(value, 10, 15)];
+            *(dst++) = 0x3c00u;
+          }
+        }
+      } break;
+
+      case D3D9ConversionFormat_X8L8V8U8: {
+        auto dst = reinterpret_cast<uint16_t*>(dstData);
+
+        for (uint32_t y = 0; y < extent.height; y++) {
+          auto src = reinterpret_cast<const uint32_t*>(srcBytes + y * srcPitch);
+
+          for (uint32_t x = 0; x < extent.width; x++) {
+            uint32_t value = src[x];
+            *(dst++) = m_luts.snorm8[bit::extract(value, 0, 7)];
+            *(dst++) = m_luts.snorm8[bit::extract(value, 8, 15)];
+            *(dst++) = m_luts.unorm8[bit::extract(value, 16, 23)];
+            *(dst++) = 0x3c00u;
+          }
+        }
+      } break;
+
+      case D3D9ConversionFormat_A2W10V10U10: {
+        auto dst = reinterpret_cast<uint16_t*>(dstData);
+
+        for (uint32_t y = 0; y < extent.height; y++) {
+          auto src = reinterpret_cast<const uint32_t*>(srcBytes + y * srcPitch);
+
+          for (uint32_t x = 0; x < extent.width; x++) {
+            uint32_t value = src[x];
+            *(dst++) = m_luts.snorm10[bit::extract(value, 0, 9)];
+            *(dst++) = m_luts.snorm10[bit::extract(value, 10, 19)];
+            *(dst++) = m_luts.snorm10[bit::extract(value, 20, 29)];
+            *(dst++) = m_luts.unorm2[bit::extract(value, 30, 31)];
+          }
+        }
+      } break;
+
+      case D3D9ConversionFormat_W11V11U10: {
+        auto dst = reinterpret_cast<int16_t*>(dstData);
+
+        for (uint32_t y = 0; y < extent.height; y++) {
+          auto src = reinterpret_cast<const uint32_t*>(srcBytes + y * srcPitch);
+
+          for (uint32_t x = 0; x < extent.width; x++) {
+            uint32_t value = src[x];
+            *(dst++) = m_luts.snorm16From10[bit::extract(value, 0, 9)];
+            *(dst++) = m_luts.snorm16From11[bit::extract(value, 10, 20)];
+            *(dst++) = m_luts.snorm16From11[bit::extract(value, 21, 31)];
+            *(dst++) = 0x7fff;
+          }
+        }
+      } break;
+
+      default:
+        Logger::warn("Unimplemented format conversion");
+        return;
+    }
+
+    // Update the cost estimate used to pick between the CPU and GPU path
+    auto t1 = dxvk::high_resolution_clock::now();
+
+    uint64_t pixelCount = std::max(uint64_t(extent.width) * uint64_t(extent.height), uint64_t(1u));
+    uint64_t ps = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count() * 1000u / pixelCount;
+
+    uint32_t& estimate = m_cpuPsPerPixel[conversionFormat.FormatType];
+    estimate = uint32_t((3u * uint64_t(estimate) + ps) / 4u);
+    estimate = std::clamp(estimate, MinCpuConversionPsPerPixel, MaxCpuConversionPsPerPixel);
+  }
+
+
   void D3D9FormatHelper::ConvertGenericFormat(
     const Rc<DxvkCommandList>&          ctx,
           D3D9_CONVERSION_FORMAT_INFO   videoFormat,
@@ -140,6 +457,109 @@ namespace dxvk {
   }
 
 
+  void D3D9FormatHelper::ConvertYuvCpu(
+          D3D9ConversionFormat          format,
+          uint32_t*                     dstData,
+    const uint8_t*                      srcData,
+          VkDeviceSize                  srcPitch,
+          VkExtent2D                    extent) const {
+    // Process rows in small runs so that the
+    // unpacked samples stay in registers or L1
+    constexpr uint32_t RunSize = 64u;
+
+    alignas(16) std::array<uint8_t, RunSize> y;
+    alignas(16) std::array<uint8_t, RunSize> u;
+    alignas(16) std::array<uint8_t, RunSize> v;
+
+    const D3D9YuvCoefficients& m = (format == D3D9ConversionFormat_YUY2 || format == D3D9ConversionFormat_UYVY)
+      ? g_yuvToRgb : g_bt709ToRgb;
+
+    for (uint32_t row = 0; row < extent.height; row++) {
+      const uint8_t* srcRow = srcData + row * srcPitch;
+      uint32_t*      dstRow = dstData + row * extent.width;
+
+      for (uint32_t x = 0; x < extent.width; x += RunSize) {
+        uint32_t count = std::min(extent.width - x, RunSize);
+
+        switch (format) {
+          case D3D9ConversionFormat_YUY2:
+          case D3D9ConversionFormat_UYVY: {
+            // Macro pixels are Y0 U Y1 V for YUY2 and U Y0 V Y1 for UYVY
+            uint32_t yIndex = format == D3D9ConversionFormat_UYVY ? 1u : 0u;
+            uint32_t cIndex = yIndex ^ 1u;
+
+            for (uint32_t i = 0; i < count; i++) {
+              const uint8_t* macroPixel = &srcRow[2u * ((x + i) & ~1u)];
+              y[i] = macroPixel[2u * ((x + i) & 1u) + yIndex];
+              u[i] = macroPixel[cIndex];
+              v[i] = macroPixel[cIndex + 2u];
+            }
+          } break;
+
+          case D3D9ConversionFormat_NV12: {
+            // Interleaved UV plane follows the Y plane, sharing its pitch
+            const uint8_t* uvRow = srcData + (extent.height + row / 2u) * srcPitch;
+
+            for (uint32_t i = 0; i < count; i++) {
+              y[i] = srcRow[x + i];
+              u[i] = uvRow[((x + i) & ~1u)];
+              v[i] = uvRow[((x + i) & ~1u) + 1u];
+            }
+          } break;
+
+          case D3D9ConversionFormat_YV12: {
+            // Tightly packed V and U planes follow the Y plane
+            uint32_t chromaPitch = extent.width / 2u;
+            uint32_t chromaSize = chromaPitch * (extent.height / 2u);
+
+            const uint8_t* vRow = srcData + extent.width * extent.height + (row / 2u) * chromaPitch;
+            const uint8_t* uRow = vRow + chromaSize;
+
+            for (uint32_t i = 0; i < count; i++) {
+              y[i] = srcRow[x + i];
+              u[i] = uRow[(x + i) / 2u];
+              v[i] = vRow[(x + i) / 2u];
+            }
+          } break;
+
+          default:
+            return;
+        }
+
+        ConvertYuvRun(m, count, &dstRow[x], y.data(), u.data(), v.data());
+      }
+    }
+  }
+
+
+  void D3D9FormatHelper::InitLuts() {
+    for (uint32_t i = 0; i < m_luts.snorm5.size(); i++)
+      m_luts.snorm5[i] = ConvertFloatToHalf(Snormalize(SignExtend(i, 5), 5));
+
+    for (uint32_t i = 0; i < m_luts.unorm6.size(); i++)
+      m_luts.unorm6[i] = ConvertFloatToHalf(Unormalize(i, 6));
+
+    for (uint32_t i = 0; i < m_luts.snorm8.size(); i++)
+      m_luts.snorm8[i] = ConvertFloatToHalf(Snormalize(SignExtend(i, 8), 8));
+
+    for (uint32_t i = 0; i < m_luts.unorm8.size(); i++)
+      m_luts.unorm8[i] = ConvertFloatToHalf(Unormalize(i, 8));
+
+    for (uint32_t i = 0; i < m_luts.snorm10.size(); i++)
+      m_luts.snorm10[i] = ConvertFloatToHalf(Snormalize(SignExtend(i, 10), 10));
+
+    for (uint32_t i = 0; i < m_luts.unorm2.size(); i++)
+      m_luts.unorm2[i] = ConvertFloatToHalf(Unormalize(i, 2));
+
+    for (uint32_t i = 0; i < m_luts.snorm16From10.size(); i++)
+      m_luts.snorm16From10[i] = ConvertFloatToSnorm16(Snormalize(SignExtend(i, 10), 10));
+
+    // The W11V11U10 shader normalizes the 11-bit components with the 10-bit range
+    for (uint32_t i = 0; i < m_luts.snorm16From11.size(); i++)
+      m_luts.snorm16From11[i] = ConvertFloatToSnorm16(Snormalize(SignExtend(i, 11), 10));
+  }
+
+
   void D3D9FormatHelper::InitPipelines() {
     m_pipelines[D3D9ConversionFormat_YUY2] = CreatePipeline(sizeof(d3d9_convert_yuy2_uyvy), d3d9_convert_yuy2_uyvy, 0);
     m_pipelines[D3D9ConversionFormat_UYVY] = CreatePipeline(sizeof(d3d9_convert_yuy2_uyvy), d3d9_convert_yuy2_uyvy, 1);
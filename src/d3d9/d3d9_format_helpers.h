@@ -7,7 +7,35 @@
 
 namespace dxvk {
 
+  /**
+   * \brief Lookup tables for CPU format conversion
+   *
+   * Maps raw bit fields of the packed source formats to
+   * the values written to the converted image, i.e. half
+   * floats or 16-bit snorm values respectively.
+   */
+  struct D3D9ConversionLuts {
+    std::array<uint16_t,   32> snorm5  = { };
+    std::array<uint16_t,   64> unorm6  = { };
+    std::array<uint16_t,  256> snorm8  = { };
+    std::array<uint16_t,  256> unorm8  = { };
+    std::array<uint16_t, 1024> snorm10 = { };
+    std::array<uint16_t,    4> unorm2  = { };
+    std::array<int16_t,  1024> snorm16From10 = { };
+    std::array<int16_t,  2048> snorm16From11 = { };
+  };
+
   class D3D9FormatHelper {
+    // Time budget for a single CPU conversion. Anything that takes longer
+    // is converted on the GPU, where we pay a dispatch and barrier instead.
+    constexpr static uint64_t CpuConversionBudgetPs = 100'000'000ull;
+
+    // Bounds for the measured conversion cost. The upper bound ensures that
+    // tiny images are always converted on the CPU, so that the estimate
+    // keeps getting updated, the lower bound limits staging memory usage.
+    constexpr static uint32_t MinCpuConversionPsPerPixel = 250u;
+    constexpr static uint32_t MaxCpuConversionPsPerPixel = 24000u;
+    constexpr static uint32_t InitCpuConversionPsPerPixel = 1000u;
 
   public:
 
@@ -24,6 +52,41 @@ namespace dxvk {
             VkImageSubresourceLayers      dstSubresource,
       const DxvkBufferSlice&              srcSlice);
 
+    /**
+     * \brief Checks whether to convert on the CPU
+     *
+     * Small uploads are converted directly into staging memory
+     * in order to avoid a compute dispatch and barrier. The size
+     * threshold is derived from the measured conversion speed.
+     * \param [in] conversionFormat Conversion format
+     * \param [in] extent Subresource extent, in pixels
+     * \param [in] srcPitch Row pitch of the source data
+     * \returns \c true if \c ConvertFormatCpu should be used
+     */
+    bool ShouldConvertOnCpu(
+            D3D9_CONVERSION_FORMAT_INFO   conversionFormat,
+            VkExtent3D                    extent,
+            VkDeviceSize                  srcPitch) const;
+
+    /**
+     * \brief Converts image data on the CPU
+     *
+     * Writes tightly packed data in the converted format. The
+     * source data must be laid out the same way as for the
+     * compute shader path, with the given row pitch.
+     * \param [in] conversionFormat Conversion format
+     * \param [out] dstData Destination data
+     * \param [in] srcData Source data
+     * \param [in] srcPitch Row pitch of the source data
+     * \param [in] extent Subresource extent, in pixels
+     */
+    void ConvertFormatCpu(
+            D3D9_CONVERSION_FORMAT_INFO   conversionFormat,
+            void*                         dstData,
+      const void*                         srcData,
+            VkDeviceSize                  srcPitch,
+            VkExtent3D                    extent);
+
   private:
 
     void ConvertGenericFormat(
@@ -52,6 +115,19 @@ namespace dxvk {
 
     std::array<VkPipeline, D3D9ConversionFormat_Count> m_pipelines = { };
 
+    D3D9ConversionLuts        m_luts;
+
+    std::array<uint32_t, D3D9ConversionFormat_Count> m_cpuPsPerPixel = { };
+
+    void InitLuts();
+
+    void ConvertYuvCpu(
+            D3D9ConversionFormat          format,
+            uint32_t*                     dstData,
+      const uint8_t*                      srcData,
+            VkDeviceSize                  srcPitch,
+            VkExtent2D                    extent) const;
+
   };
   
 }
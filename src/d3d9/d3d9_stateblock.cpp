@@ -96,6 +96,8 @@ namespace dxvk {
   HRESULT D3D9StateBlock::SetRenderState(D3DRENDERSTATETYPE State, DWORD Value) {
     m_state.renderStates[State] = Value;
 
+    m_tapeDirty |= !m_captures.renderStates.get(State);
+
     m_captures.flags.set(D3D9CapturedStateFlag::RenderStates);
     m_captures.renderStates.set(State, true);
     return D3D_OK;
@@ -108,6 +110,8 @@ namespace dxvk {
           DWORD               Value) {
     m_state.samplerStates[StateSampler][Type] = Value;
 
+    m_tapeDirty |= !m_captures.samplerStates[StateSampler].get(Type);
+
     m_captures.flags.set(D3D9CapturedStateFlag::SamplerStates);
     m_captures.samplers.set(StateSampler, true);
     m_captures.samplerStates[StateSampler].set(Type, true);
@@ -221,6 +225,8 @@ namespace dxvk {
   HRESULT D3D9StateBlock::SetStateTransform(uint32_t idx, const D3DMATRIX* pMatrix) {
     m_state.transforms[idx] = ConvertMatrix(pMatrix);
 
+    m_tapeDirty |= !m_captures.transforms.get(idx);
+
     m_captures.flags.set(D3D9CapturedStateFlag::Transforms);
     m_captures.transforms.set(idx, true);
     return D3D_OK;
@@ -236,6 +242,8 @@ namespace dxvk {
 
     m_state.textureStages[Stage][Type] = Value;
 
+    m_tapeDirty |= !m_captures.textureStageStates[Stage].get(Type);
+
     m_captures.flags.set(D3D9CapturedStateFlag::TextureStages);
     m_captures.textureStages.set(Stage, true);
     m_captures.textureStageStates[Stage].set(Type, true);
@@ -531,7 +539,66 @@ namespace dxvk {
   }
 
 
+  template <size_t Bits>
+  static void CompileRanges(
+          std::vector<D3D9StateBlockRange>& Ranges,
+    const bit::bitset<Bits>&                Mask) {
+    Ranges.clear();
+
+    for (uint32_t i = 0; i < Mask.dwordCount(); i++) {
+      for (uint32_t bit : bit::BitMask(Mask.dword(i))) {
+        uint32_t idx = i * 32 + bit;
+
+        if (!Ranges.empty() && Ranges.back().start + Ranges.back().count == idx)
+          Ranges.back().count += 1;
+        else
+          Ranges.push_back({ idx, 1u });
+      }
+    }
+  }
+
+
+  void D3D9StateBlock::CompileTape() {
+    m_tape.renderStates.clear();
+
+    for (uint32_t i = 0; i < m_captures.renderStates.dwordCount(); i++) {
+      for (uint32_t rs : bit::BitMask(m_captures.renderStates.dword(i)))
+        m_tape.renderStates.push_back(i * 32 + rs);
+    }
+
+    m_tape.samplerStates.clear();
+
+    for (uint32_t samplerIdx : bit::BitMask(m_captures.samplers.dword(0))) {
+      for (uint32_t stateIdx : bit::BitMask(m_captures.samplerStates[samplerIdx].dword(0)))
+        m_tape.samplerStates.push_back({ uint8_t(samplerIdx), uint8_t(stateIdx) });
+    }
+
+    m_tape.textureStageStates.clear();
+
+    for (uint32_t stageIdx : bit::BitMask(m_captures.textureStages.dword(0))) {
+      for (uint32_t stateIdx : bit::BitMask(m_captures.textureStageStates[stageIdx].dword(0)))
+        m_tape.textureStageStates.push_back({ uint8_t(stageIdx), uint8_t(stateIdx) });
+    }
+
+    m_tape.transforms.clear();
+
+    for (uint32_t i = 0; i < m_captures.transforms.dwordCount(); i++) {
+      for (uint32_t trans : bit::BitMask(m_captures.transforms.dword(i)))
+        m_tape.transforms.push_back(i * 32 + trans);
+    }
+
+    CompileRanges(m_tape.vsFloatConsts, m_captures.vsConsts.fConsts);
+    CompileRanges(m_tape.vsIntConsts,   m_captures.vsConsts.iConsts);
+    CompileRanges(m_tape.psFloatConsts, m_captures.psConsts.fConsts);
+    CompileRanges(m_tape.psIntConsts,   m_captures.psConsts.iConsts);
+
+    m_tapeDirty = false;
+  }
+
+
   void D3D9StateBlock::CaptureType(D3D9StateBlockType Type) {
+    m_tapeDirty = true;
+
     if (Type == D3D9StateBlockType::PixelState || Type == D3D9StateBlockType::All) {
       CapturePixelRenderStates();
       CapturePixelSamplerStates();
@@ -66,6 +66,43 @@ namespace dxvk {
     bit::bitvector                                      lightEnabledChanges;
   };
 
+  /**
+   * \brief Contiguous range of captured registers
+   */
+  struct D3D9StateBlockRange {
+    uint32_t start;
+    uint32_t count;
+  };
+
+  /**
+   * \brief Captured per-stage or per-sampler state
+   */
+  struct D3D9StateBlockStageState {
+    uint8_t  stage;
+    uint8_t  state;
+  };
+
+  /**
+   * \brief Compiled state block captures
+   *
+   * Flat lists of captured states built from the capture masks, so
+   * that applying a state block does not need to scan the masks bit
+   * by bit, and so that shader constants can be written as contiguous
+   * ranges rather than one register at a time. Rebuilt whenever the
+   * set of captured states changes.
+   */
+  struct D3D9StateBlockTape {
+    std::vector<uint32_t>                 renderStates;
+    std::vector<D3D9StateBlockStageState> samplerStates;
+    std::vector<D3D9StateBlockStageState> textureStageStates;
+    std::vector<uint32_t>                 transforms;
+
+    std::vector<D3D9StateBlockRange>      vsFloatConsts;
+    std::vector<D3D9StateBlockRange>      vsIntConsts;
+    std::vector<D3D9StateBlockRange>      psFloatConsts;
+    std::vector<D3D9StateBlockRange>      psIntConsts;
+  };
+
   enum class D3D9StateBlockType : uint8_t {
     None,
     All,
@@ -187,6 +224,8 @@ namespace dxvk {
 
     template <typename Dst, typename Src, bool IgnoreStreamOffset>
     void ApplyOrCapture(Dst* dst, const Src* src) {
+      const D3D9StateBlockTape& tape = GetTape();
+
       if (m_captures.flags.test(D3D9CapturedStateFlag::StreamFreq)) {
         for (uint32_t idx : bit::BitMask(m_captures.streamFreq.dword(0)))
           dst->SetStreamSourceFreq(idx, src->streamFreq[idx]);
@@ -196,20 +235,13 @@ namespace dxvk {
         dst->SetIndices(src->indices.ptr());
 
       if (m_captures.flags.test(D3D9CapturedStateFlag::RenderStates)) {
-        for (uint32_t i = 0; i < m_captures.renderStates.dwordCount(); i++) {
-          for (uint32_t rs : bit::BitMask(m_captures.renderStates.dword(i))) {
-            uint32_t idx = i * 32 + rs;
-
-            dst->SetRenderState(D3DRENDERSTATETYPE(idx), src->renderStates[idx]);
-          }
-        }
+        for (uint32_t idx : tape.renderStates)
+          dst->SetRenderState(D3DRENDERSTATETYPE(idx), src->renderStates[idx]);
       }
 
       if (m_captures.flags.test(D3D9CapturedStateFlag::SamplerStates)) {
-        for (uint32_t samplerIdx : bit::BitMask(m_captures.samplers.dword(0))) {
-          for (uint32_t stateIdx : bit::BitMask(m_captures.samplerStates[samplerIdx].dword(0)))
-            dst->SetStateSamplerState(samplerIdx, D3DSAMPLERSTATETYPE(stateIdx), src->samplerStates[samplerIdx][stateIdx]);
-        }
+        for (const auto& s : tape.samplerStates)
+          dst->SetStateSamplerState(s.stage, D3DSAMPLERSTATETYPE(s.state), src->samplerStates[s.stage][s.state]);
       }
 
       if (m_captures.flags.test(D3D9CapturedStateFlag::VertexBuffers)) {
@@ -246,20 +278,13 @@ namespace dxvk {
         dst->SetPixelShader(src->pixelShader.ptr());
 
       if (m_captures.flags.test(D3D9CapturedStateFlag::Transforms)) {
-        for (uint32_t i = 0; i < m_captures.transforms.dwordCount(); i++) {
-          for (uint32_t trans : bit::BitMask(m_captures.transforms.dword(i))) {
-            uint32_t idx = i * 32 + trans;
-
-            dst->SetStateTransform(idx, reinterpret_cast<const D3DMATRIX*>(&src->transforms[idx]));
-          }
-        }
+        for (uint32_t idx : tape.transforms)
+          dst->SetStateTransform(idx, reinterpret_cast<const D3DMATRIX*>(&src->transforms[idx]));
       }
 
       if (m_captures.flags.test(D3D9CapturedStateFlag::TextureStages)) {
-        for (uint32_t stageIdx : bit::BitMask(m_captures.textureStages.dword(0))) {
-          for (uint32_t stateIdx : bit::BitMask(m_captures.textureStageStates[stageIdx].dword(0)))
-            dst->SetStateTextureStageState(stageIdx, D3D9TextureStageStateTypes(stateIdx), src->textureStages[stageIdx][stateIdx]);
-        }
+        for (const auto& s : tape.textureStageStates)
+          dst->SetStateTextureStageState(s.stage, D3D9TextureStageStateTypes(s.state), src->textureStages[s.stage][s.state]);
       }
 
       if (m_captures.flags.test(D3D9CapturedStateFlag::Viewport))
@@ -274,21 +299,11 @@ namespace dxvk {
       }
 
       if (m_captures.flags.test(D3D9CapturedStateFlag::VsConstants)) {
-        for (uint32_t i = 0; i < m_captures.vsConsts.fConsts.dwordCount(); i++) {
-          for (uint32_t consts : bit::BitMask(m_captures.vsConsts.fConsts.dword(i))) {
-            uint32_t idx = i * 32 + consts;
+        for (const auto& r : tape.vsFloatConsts)
+          dst->SetVertexShaderConstantF(r.start, reinterpret_cast<const float*>(&src->vsConsts->fConsts[r.start]), r.count);
 
-            dst->SetVertexShaderConstantF(idx, reinterpret_cast<const float*>(&src->vsConsts->fConsts[idx]), 1);
-          }
-        }
-
-        for (uint32_t i = 0; i < m_captures.vsConsts.iConsts.dwordCount(); i++) {
-          for (uint32_t consts : bit::BitMask(m_captures.vsConsts.iConsts.dword(i))) {
-            uint32_t idx = i * 32 + consts;
-
-            dst->SetVertexShaderConstantI(idx, reinterpret_cast<const int*>(&src->vsConsts->iConsts[idx]), 1);
-          }
-        }
+        for (const auto& r : tape.vsIntConsts)
+          dst->SetVertexShaderConstantI(r.start, reinterpret_cast<const int*>(&src->vsConsts->iConsts[r.start]), r.count);
 
         if (m_captures.vsConsts.bConsts.any()) {
           for (uint32_t i = 0; i < m_captures.vsConsts.bConsts.dwordCount(); i++)
@@ -297,21 +312,11 @@ namespace dxvk {
       }
 
       if (m_captures.flags.test(D3D9CapturedStateFlag::PsConstants)) {
-        for (uint32_t i = 0; i < m_captures.psConsts.fConsts.dwordCount(); i++) {
-          for (uint32_t consts : bit::BitMask(m_captures.psConsts.fConsts.dword(i))) {
-            uint32_t idx = i * 32 + consts;
-
-            dst->SetPixelShaderConstantF(idx, reinterpret_cast<const float*>(&src->psConsts->fConsts[idx]), 1);
-          }
-        }
-
-        for (uint32_t i = 0; i < m_captures.psConsts.iConsts.dwordCount(); i++) {
-          for (uint32_t consts : bit::BitMask(m_captures.psConsts.iConsts.dword(i))) {
-            uint32_t idx = i * 32 + consts;
+        for (const auto& r : tape.psFloatConsts)
+          dst->SetPixelShaderConstantF(r.start, reinterpret_cast<const float*>(&src->psConsts->fConsts[r.start]), r.count);
 
-            dst->SetPixelShaderConstantI(idx, reinterpret_cast<const int*>(&src->psConsts->iConsts[idx]), 1);
-          }
-        }
+        for (const auto& r : tape.psIntConsts)
+          dst->SetPixelShaderConstantI(r.start, reinterpret_cast<const int*>(&src->psConsts->iConsts[r.start]), r.count);
 
         if (m_captures.psConsts.bConsts.any()) {
           for (uint32_t i = 0; i < m_captures.psConsts.bConsts.dwordCount(); i++)
@@ -362,12 +367,15 @@ namespace dxvk {
 
         for (uint32_t i = 0; i < Count; i++) {
           uint32_t reg = StartRegister + i;
-          if      constexpr (ConstantType == D3D9ConstantType::Float)
+          if      constexpr (ConstantType == D3D9ConstantType::Float) {
+            m_tapeDirty |= !setCaptures.fConsts.get(reg);
             setCaptures.fConsts.set(reg, true);
-          else if constexpr (ConstantType == D3D9ConstantType::Int)
+          } else if constexpr (ConstantType == D3D9ConstantType::Int) {
+            m_tapeDirty |= !setCaptures.iConsts.get(reg);
             setCaptures.iConsts.set(reg, true);
-          else if constexpr (ConstantType == D3D9ConstantType::Bool)
+          } else if constexpr (ConstantType == D3D9ConstantType::Bool) {
             setCaptures.bConsts.set(reg, true);
+          }
         }
 
         UpdateStateConstants<ShaderType, ConstantType, T>(
@@ -396,9 +404,21 @@ namespace dxvk {
 
     void CaptureType(D3D9StateBlockType State);
 
+    void CompileTape();
+
+    const D3D9StateBlockTape& GetTape() {
+      if (unlikely(m_tapeDirty))
+        CompileTape();
+
+      return m_tape;
+    }
+
     D3D9CapturableState  m_state;
     D3D9StateCaptures    m_captures;
 
+    D3D9StateBlockTape   m_tape;
+    bool                 m_tapeDirty = true;
+
     D3D9DeviceState*     m_deviceState;
 
   };
@@ -936,6 +936,9 @@ namespace dxvk {
     if (m_latencyHud)
       m_latencyHud->accumulateStats(latencyStats);
 
+    if (m_pacingHud)
+      m_pacingHud->accumulateStats(m_wctx->presenter->getFramePacingStats());
+
     // Rotate swap chain buffers so that the back
     // buffer at index 0 becomes the front buffer.
     uint32_t rotatingBufferCount = m_backBuffers.size();
@@ -1087,6 +1090,8 @@ namespace dxvk {
       if (m_latencyTracking)
         m_latencyHud = hud->addItem<hud::HudLatencyItem>("latency", 4);
 
+      m_pacingHud = hud->addItem<hud::HudFramePacingItem>("pacing", 5);
+
       hud->addItem<hud::HudSWVPState>("swvp", -1, m_parent);
 
 #ifdef DXVK_USE_UNMAPPABLE_MEMORY
@@ -522,4 +522,14 @@ namespace dxvk {
     flush(list);
   }
 
+
+  void DxvkBarrierBatch::discardDeviceBarriers() {
+    m_memoryBarrier.srcStageMask = 0u;
+    m_memoryBarrier.srcAccessMask = 0u;
+    m_memoryBarrier.dstStageMask = 0u;
+    m_memoryBarrier.dstAccessMask = 0u;
+
+    m_imageBarriers.clear();
+  }
+
 }
@@ -339,6 +339,15 @@ namespace dxvk {
     void finalize(
       const Rc<DxvkCommandList>&        list);
 
+    /**
+     * \brief Discards batched device barriers
+     *
+     * Useful if the affected accesses are already synchronized
+     * through other means, e.g. semaphores. Pending host access
+     * is kept and will still be flushed on \c finalize.
+     */
+    void discardDeviceBarriers();
+
     /**
      * \brief Check whether there are pending layout transitions
      * \returns \c true if there are any image layout transitions
@@ -6,6 +6,9 @@
 namespace dxvk {
 
   DxvkDeviceQueue getQueueForCommandBuffer(DxvkDevice* device, DxvkCmdBuffer cmdBuffer) {
+    if (cmdBuffer == DxvkCmdBuffer::AsyncBuffer)
+      return device->queues().compute;
+
     return cmdBuffer < DxvkCmdBuffer::SdmaBuffer
       ? device->queues().graphics
       : device->queues().transfer;
@@ -110,6 +113,117 @@ namespace dxvk {
   }
 
 
+  DxvkSubmissionBatch::DxvkSubmissionBatch() {
+
+  }
+
+
+  DxvkSubmissionBatch::~DxvkSubmissionBatch() {
+
+  }
+
+
+  VkResult DxvkSubmissionBatch::addSubmission(
+          DxvkDevice*             device,
+          VkQueue                 queue,
+          DxvkCommandSubmission&  submission,
+          uint64_t                frameId) {
+    VkResult vr = VK_SUCCESS;
+
+    if (submission.isEmpty())
+      return vr;
+
+    // Batches can only be merged if they target the same queue. Any
+    // cross-queue semaphore wait must be submitted after the signal.
+    if (m_queue != queue) {
+      vr = flush(device);
+      m_queue = queue;
+    }
+
+    Batch& batch = m_batches.emplace_back();
+    batch.waitIndex = m_semaphoreWaits.size();
+    batch.waitCount = submission.m_semaphoreWaits.size();
+    batch.signalIndex = m_semaphoreSignals.size();
+    batch.signalCount = submission.m_semaphoreSignals.size();
+    batch.cmdBufferIndex = m_commandBuffers.size();
+    batch.cmdBufferCount = submission.m_commandBuffers.size();
+    batch.frameId = frameId;
+
+    for (const auto& wait : submission.m_semaphoreWaits)
+      m_semaphoreWaits.push_back(wait);
+
+    for (const auto& signal : submission.m_semaphoreSignals)
+      m_semaphoreSignals.push_back(signal);
+
+    for (const auto& cmdBuffer : submission.m_commandBuffers)
+      m_commandBuffers.push_back(cmdBuffer);
+
+    submission.reset();
+    return vr;
+  }
+
+
+  VkResult DxvkSubmissionBatch::flush(
+          DxvkDevice*             device) {
+    if (m_batches.empty())
+      return VK_SUCCESS;
+
+    auto vk = device->vkd();
+
+    // Build submit infos only now since the
+    // arrays may have been reallocated before
+    m_submitInfos.resize(m_batches.size());
+    m_latencyInfos.resize(m_batches.size());
+
+    for (size_t i = 0; i < m_batches.size(); i++) {
+      const auto& batch = m_batches[i];
+
+      auto& submitInfo = m_submitInfos[i];
+      submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO_2 };
+
+      if (batch.waitCount) {
+        submitInfo.waitSemaphoreInfoCount = batch.waitCount;
+        submitInfo.pWaitSemaphoreInfos = &m_semaphoreWaits[batch.waitIndex];
+      }
+
+      if (batch.cmdBufferCount) {
+        submitInfo.commandBufferInfoCount = batch.cmdBufferCount;
+        submitInfo.pCommandBufferInfos = &m_commandBuffers[batch.cmdBufferIndex];
+      }
+
+      if (batch.signalCount) {
+        submitInfo.signalSemaphoreInfoCount = batch.signalCount;
+        submitInfo.pSignalSemaphoreInfos = &m_semaphoreSignals[batch.signalIndex];
+      }
+
+      if (batch.frameId && device->features().nvLowLatency2) {
+        auto& latencyInfo = m_latencyInfos[i];
+        latencyInfo = { VK_STRUCTURE_TYPE_LATENCY_SUBMISSION_PRESENT_ID_NV };
+        latencyInfo.presentID = batch.frameId;
+
+        submitInfo.pNext = &latencyInfo;
+      }
+    }
+
+    VkResult vr = vk->vkQueueSubmit2(m_queue,
+      m_submitInfos.size(), m_submitInfos.data(), VK_NULL_HANDLE);
+
+    m_submitCount += 1u;
+
+    this->reset();
+    return vr;
+  }
+
+
+  void DxvkSubmissionBatch::reset() {
+    m_batches.clear();
+
+    m_semaphoreWaits.clear();
+    m_semaphoreSignals.clear();
+    m_commandBuffers.clear();
+  }
+
+
   DxvkCommandPool::DxvkCommandPool(
           DxvkDevice*           device,
           uint32_t              queueFamily)
@@ -170,6 +284,7 @@ namespace dxvk {
         case DxvkCmdBuffer::InitBarriers: label = vk::makeLabel(0xd0e6b8, "Init barriers"); break;
         case DxvkCmdBuffer::SdmaBuffer: label = vk::makeLabel(0xc0a2dc, "Upload commands"); break;
         case DxvkCmdBuffer::SdmaBarriers: label = vk::makeLabel(0xd0b8e6, "Upload barriers"); break;
+        case DxvkCmdBuffer::AsyncBuffer: label = vk::makeLabel(0xa2c0dc, "Async compute commands"); break;
         default: ;
       }
 
@@ -243,6 +358,9 @@ namespace dxvk {
     else
       m_transferPool = m_graphicsPool;
 
+    if (m_device->hasAsyncComputeQueue())
+      m_computePool = new DxvkCommandPool(device, m_device->queues().compute.queueFamily);
+
     resetCheckpoints();
   }
   
@@ -255,7 +373,8 @@ namespace dxvk {
   VkResult DxvkCommandList::submit(
     const DxvkTimelineSemaphores&       semaphores,
           DxvkTimelineSemaphoreValues&  timelines,
-          uint64_t                      trackedId) {
+          uint64_t                      trackedId,
+          DxvkSubmissionBatch&          batch) {
     // Wait for pending descriptor copies to finish
     m_descriptorSync.synchronize();
 
@@ -269,9 +388,14 @@ namespace dxvk {
     const auto& graphics = m_device->queues().graphics;
     const auto& transfer = m_device->queues().transfer;
     const auto& sparse = m_device->queues().sparse;
+    const auto& compute = m_device->queues().compute;
 
     m_commandSubmission.reset();
 
+    // Compute timeline value that subsequent graphics
+    // submissions within this command list must wait for
+    uint64_t computeWait = 0u;
+
     for (size_t i = 0; i < m_cmdSubmissions.size(); i++) {
       bool isFirst = i == 0;
       bool isLast  = i == m_cmdSubmissions.size() - 1;
@@ -298,6 +422,10 @@ namespace dxvk {
 
         sparseBind->signalSemaphore(semaphores.graphics, ++timelines.graphics);
 
+        // Prior batches must be submitted before the bind can wait for them
+        if ((status = batch.flush(m_device)))
+          return status;
+
         if ((status = sparseBind->submit(m_device, sparse.queueHandle)))
           return status;
 
@@ -317,13 +445,21 @@ namespace dxvk {
         m_commandSubmission.signalSemaphore(semaphores.transfer,
           ++timelines.transfer, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT);
 
-        if ((status = m_commandSubmission.submit(m_device, transfer.queueHandle, trackedId)))
+        if ((status = batch.addSubmission(m_device, transfer.queueHandle, m_commandSubmission, trackedId)))
           return status;
 
         m_commandSubmission.waitSemaphore(semaphores.transfer,
           timelines.transfer, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT);
       }
 
+      // Async compute work recorded in a previous submission
+      // may write resources used by subsequent commands
+      if (computeWait) {
+        m_commandSubmission.waitSemaphore(semaphores.compute,
+          computeWait, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+        computeWait = 0u;
+      }
+
       // We promise to never do weird stuff to WSI images on
       // the transfer queue, so blocking graphics is sufficient
       if (isFirst && m_wsiSemaphores.acquire) {
@@ -341,6 +477,40 @@ namespace dxvk {
       if (cmd.execCommands)
         m_commandSubmission.executeCommandBuffer(cmd.cmdBuffers[uint32_t(DxvkCmdBuffer::ExecBuffer)]);
 
+      // Async compute commands only access resources that are not used by any
+      // graphics commands of the same submission, so it is sufficient to wait
+      // for prior submissions to complete before they can start executing.
+      VkCommandBuffer asyncBuffer = cmd.cmdBuffers[uint32_t(DxvkCmdBuffer::AsyncBuffer)];
+
+      if (asyncBuffer) {
+        DxvkCommandSubmission asyncSubmission;
+        asyncSubmission.waitSemaphore(semaphores.graphics,
+          timelines.graphics, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+        asyncSubmission.waitSemaphore(semaphores.transfer,
+          timelines.transfer, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+        asyncSubmission.waitSemaphore(semaphores.compute,
+          timelines.compute, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+
+        if (isFirst) {
+          // The graphics submission that waits for per-command list
+          // semaphores may not have been submitted yet, so wait for
+          // them here as well in order to not run ahead of them
+          for (size_t i = 0; i < m_waitSemaphores.size(); i++) {
+            asyncSubmission.waitSemaphore(m_waitSemaphores[i].fence->handle(),
+              m_waitSemaphores[i].value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+          }
+        }
+
+        asyncSubmission.executeCommandBuffer(asyncBuffer);
+        asyncSubmission.signalSemaphore(semaphores.compute,
+          ++timelines.compute, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+
+        if ((status = batch.addSubmission(m_device, compute.queueHandle, asyncSubmission, trackedId)))
+          return status;
+
+        computeWait = timelines.compute;
+      }
+
       if (isLast) {
         // Signal per-command list semaphores on the final submission
         for (size_t i = 0; i < m_signalSemaphores.size(); i++) {
@@ -359,7 +529,7 @@ namespace dxvk {
         ++timelines.graphics, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT);
 
       // Finally, submit all graphics commands of the current submission
-      if ((status = m_commandSubmission.submit(m_device, graphics.queueHandle, trackedId)))
+      if ((status = batch.addSubmission(m_device, graphics.queueHandle, m_commandSubmission, trackedId)))
         return status;
 
       // If there are WSI semaphores involved, do another submit only
@@ -369,7 +539,7 @@ namespace dxvk {
         m_commandSubmission.signalSemaphore(semaphores.graphics,
           ++timelines.graphics, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT);
 
-        if ((status = m_commandSubmission.submit(m_device, graphics.queueHandle, trackedId)))
+        if ((status = batch.addSubmission(m_device, graphics.queueHandle, m_commandSubmission, trackedId)))
           return status;
       }
 
@@ -379,7 +549,7 @@ namespace dxvk {
         m_commandSubmission.waitSemaphore(semaphores.graphics,
           timelines.graphics, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT);
 
-        if (isLast && (status = m_commandSubmission.submit(m_device, transfer.queueHandle, trackedId)))
+        if (isLast && (status = batch.addSubmission(m_device, transfer.queueHandle, m_commandSubmission, trackedId)))
           return status;
       }
     }
@@ -429,10 +599,6 @@ namespace dxvk {
 
     // Reset all command buffer handles
     m_cmd = DxvkCommandSubmissionInfo();
-
-    // Increment queue submission count
-    uint64_t submissionCount = m_cmdSubmissions.size();
-    m_statCounters.addCtr(DxvkStatCounter::QueueSubmitCount, submissionCount);
   }
 
 
@@ -505,6 +671,9 @@ namespace dxvk {
     // Reset actual command buffers and pools
     m_graphicsPool->reset();
     m_transferPool->reset();
+
+    if (m_computePool)
+      m_computePool->reset();
   }
 
 
@@ -927,6 +1096,26 @@ namespace dxvk {
   }
 
 
+  void DxvkCommandList::beginAsyncCompute() {
+    auto& asyncBuffer = m_cmd.cmdBuffers[uint32_t(DxvkCmdBuffer::AsyncBuffer)];
+
+    if (!asyncBuffer)
+      asyncBuffer = allocateCommandBuffer(DxvkCmdBuffer::AsyncBuffer);
+
+    std::swap(m_cmd.cmdBuffers[uint32_t(DxvkCmdBuffer::ExecBuffer)], asyncBuffer);
+    std::swap(m_checkpointIds[uint32_t(DxvkCmdBuffer::ExecBuffer)],
+              m_checkpointIds[uint32_t(DxvkCmdBuffer::AsyncBuffer)]);
+  }
+
+
+  void DxvkCommandList::endAsyncCompute() {
+    std::swap(m_cmd.cmdBuffers[uint32_t(DxvkCmdBuffer::ExecBuffer)],
+              m_cmd.cmdBuffers[uint32_t(DxvkCmdBuffer::AsyncBuffer)]);
+    std::swap(m_checkpointIds[uint32_t(DxvkCmdBuffer::ExecBuffer)],
+              m_checkpointIds[uint32_t(DxvkCmdBuffer::AsyncBuffer)]);
+  }
+
+
   void DxvkCommandList::cmdExecuteCommands(
           uint32_t                count,
           VkCommandBuffer*        commandBuffers) {
@@ -964,6 +1153,8 @@ namespace dxvk {
     // Secondary command buffer must not be active when this gets called
     for (uint32_t i = uint32_t(DxvkCmdBuffer::ExecBuffer); i <= uint32_t(DxvkCmdBuffer::InitBarriers); i++)
       bindSamplerHeap(m_cmd.cmdBuffers[i]);
+
+    bindSamplerHeap(m_cmd.cmdBuffers[uint32_t(DxvkCmdBuffer::AsyncBuffer)]);
   }
 
 
@@ -971,6 +1162,8 @@ namespace dxvk {
     // Secondary command buffer must not be active when this gets called
     for (uint32_t i = uint32_t(DxvkCmdBuffer::ExecBuffer); i <= uint32_t(DxvkCmdBuffer::InitBarriers); i++)
       bindResourceHeap(m_cmd.cmdBuffers[i]);
+
+    bindResourceHeap(m_cmd.cmdBuffers[uint32_t(DxvkCmdBuffer::AsyncBuffer)]);
   }
 
 
@@ -978,6 +1171,8 @@ namespace dxvk {
     // Secondary command buffer must not be active when this gets called
     for (uint32_t i = uint32_t(DxvkCmdBuffer::ExecBuffer); i <= uint32_t(DxvkCmdBuffer::InitBuffer); i++)
       bindDescriptorBuffers(m_cmd.cmdBuffers[i]);
+
+    bindDescriptorBuffers(m_cmd.cmdBuffers[uint32_t(DxvkCmdBuffer::AsyncBuffer)]);
   }
 
 
@@ -1040,16 +1235,23 @@ namespace dxvk {
 
 
   VkCommandBuffer DxvkCommandList::allocateCommandBuffer(DxvkCmdBuffer type) {
-    VkCommandBuffer cmdBuffer = (type >= DxvkCmdBuffer::SdmaBuffer)
-      ? m_transferPool->getCommandBuffer(type)
-      : m_graphicsPool->getCommandBuffer(type);
+    VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
+
+    if (type == DxvkCmdBuffer::AsyncBuffer)
+      cmdBuffer = m_computePool->getCommandBuffer(type);
+    else if (type >= DxvkCmdBuffer::SdmaBuffer)
+      cmdBuffer = m_transferPool->getCommandBuffer(type);
+    else
+      cmdBuffer = m_graphicsPool->getCommandBuffer(type);
+
+    bool isAsync = type == DxvkCmdBuffer::AsyncBuffer;
 
-    if (type <= DxvkCmdBuffer::InitBarriers && m_device->canUseDescriptorHeap()) {
+    if ((type <= DxvkCmdBuffer::InitBarriers || isAsync) && m_device->canUseDescriptorHeap()) {
       bindSamplerHeap(cmdBuffer);
       bindResourceHeap(cmdBuffer);
     }
 
-    if (type <= DxvkCmdBuffer::InitBuffer && m_device->canUseDescriptorBuffer())
+    if ((type <= DxvkCmdBuffer::InitBuffer || isAsync) && m_device->canUseDescriptorBuffer())
       bindDescriptorBuffers(cmdBuffer);
 
     return cmdBuffer;
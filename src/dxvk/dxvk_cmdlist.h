@@ -43,13 +43,16 @@ namespace dxvk {
 
   
   /**
-   * \brief Timeline semaphore pair
+   * \brief Timeline semaphores
    *
-   * One semaphore for each queue.
+   * One semaphore for each queue. The compute
+   * semaphore is only valid if the device has
+   * an async compute queue.
    */
   struct DxvkTimelineSemaphores {
     VkSemaphore graphics = VK_NULL_HANDLE;
     VkSemaphore transfer = VK_NULL_HANDLE;
+    VkSemaphore compute  = VK_NULL_HANDLE;
   };
 
 
@@ -59,6 +62,7 @@ namespace dxvk {
   struct DxvkTimelineSemaphoreValues {
     uint64_t graphics = 0u;
     uint64_t transfer = 0u;
+    uint64_t compute  = 0u;
   };
 
 
@@ -74,6 +78,7 @@ namespace dxvk {
     InitBarriers,
     SdmaBuffer,
     SdmaBarriers,
+    AsyncBuffer,
 
     Count
   };
@@ -150,6 +155,8 @@ namespace dxvk {
 
   private:
 
+    friend class DxvkSubmissionBatch;
+
     small_vector<VkSemaphoreSubmitInfo, 4>      m_semaphoreWaits;
     small_vector<VkSemaphoreSubmitInfo, 4>      m_semaphoreSignals;
     small_vector<VkCommandBufferSubmitInfo, 4>  m_commandBuffers;
@@ -157,6 +164,86 @@ namespace dxvk {
   };
 
 
+  /**
+   * \brief Queue submission batch
+   *
+   * Collects submissions for a single queue so that they
+   * can be passed to the driver with one vkQueueSubmit2
+   * call. Batches are submitted in the order they were
+   * added, so timeline semaphore ordering is preserved.
+   * Adding a submission for a different queue will first
+   * submit all pending batches.
+   */
+  class DxvkSubmissionBatch {
+
+  public:
+
+    DxvkSubmissionBatch();
+    ~DxvkSubmissionBatch();
+
+    /**
+     * \brief Adds a submission as a new batch
+     *
+     * Moves all semaphores and command buffers of the given
+     * submission into a new batch and resets the submission.
+     * \param [in] device DXVK device
+     * \param [in] queue Queue to submit to
+     * \param [in] submission Submission to add
+     * \param [in] frameId Latency frame ID
+     * \returns Status of flushing previous batches
+     */
+    VkResult addSubmission(
+            DxvkDevice*             device,
+            VkQueue                 queue,
+            DxvkCommandSubmission&  submission,
+            uint64_t                frameId);
+
+    /**
+     * \brief Submits all pending batches
+     *
+     * \param [in] device DXVK device
+     * \returns Submission return value
+     */
+    VkResult flush(
+            DxvkDevice*             device);
+
+    /**
+     * \brief Number of queue submissions performed
+     * \returns Total number of submit calls
+     */
+    uint64_t getSubmitCount() const {
+      return m_submitCount;
+    }
+
+  private:
+
+    struct Batch {
+      uint32_t waitIndex;
+      uint32_t waitCount;
+      uint32_t signalIndex;
+      uint32_t signalCount;
+      uint32_t cmdBufferIndex;
+      uint32_t cmdBufferCount;
+      uint64_t frameId;
+    };
+
+    VkQueue                                 m_queue = VK_NULL_HANDLE;
+    uint64_t                                m_submitCount = 0u;
+
+    std::vector<Batch>                      m_batches;
+
+    std::vector<VkSemaphoreSubmitInfo>      m_semaphoreWaits;
+    std::vector<VkSemaphoreSubmitInfo>      m_semaphoreSignals;
+    std::vector<VkCommandBufferSubmitInfo>  m_commandBuffers;
+
+    std::vector<VkSubmitInfo2>                  m_submitInfos;
+    std::vector<VkLatencySubmissionPresentIdNV> m_latencyInfos;
+
+    void reset();
+
+  };
+
+
   /**
    * \brief Command submission info
    *
@@ -252,15 +339,21 @@ namespace dxvk {
     /**
      * \brief Submits command list
      *
+     * Submissions are recorded into the given batch, which
+     * may still hold pending batches when this returns. The
+     * caller must flush the batch before the command list
+     * can be considered submitted.
      * \param [in] semaphores Timeline semaphore pair
      * \param [in] timelines Timeline semaphore values
      * \param [in] frameId Latency frame ID
+     * \param [in,out] batch Submission batch
      * \returns Submission status
      */
     VkResult submit(
       const DxvkTimelineSemaphores&       semaphores,
             DxvkTimelineSemaphoreValues&  timelines,
-            uint64_t                      frameId);
+            uint64_t                      frameId,
+            DxvkSubmissionBatch&          batch);
     
     /**
      * \brief Stat counters
@@ -543,6 +636,26 @@ namespace dxvk {
      */
     VkCommandBuffer endSecondaryCommandBuffer();
 
+    /**
+     * \brief Begins recording async compute commands
+     *
+     * All subsequent commands targeted at the execution
+     * command buffer will be recorded into the async
+     * compute command buffer instead, until
+     * \c endAsyncCompute is called. Must not be called
+     * while a secondary command buffer is active.
+     */
+    void beginAsyncCompute();
+
+    /**
+     * \brief Ends recording async compute commands
+     *
+     * Restores the execution command buffer. The async compute
+     * command buffer will be submitted to the compute queue
+     * alongside the graphics commands of the current submission.
+     */
+    void endAsyncCompute();
+
     /**
      * \brief Records secondary command buffers into primary
      *
@@ -1362,6 +1475,7 @@ namespace dxvk {
     
     Rc<DxvkCommandPool>       m_graphicsPool;
     Rc<DxvkCommandPool>       m_transferPool;
+    Rc<DxvkCommandPool>       m_computePool;
 
     DxvkCommandSubmissionInfo m_cmd;
     VkCommandBuffer           m_execBuffer = VK_NULL_HANDLE;
@@ -75,6 +75,10 @@ namespace dxvk {
     if (m_device->debugFlags().test(DxvkDebugFlag::Capture))
       m_features.set(DxvkContextFeature::DebugUtils);
 
+    // Async compute submissions would break up debug regions
+    if (m_device->hasAsyncComputeQueue() && !m_features.test(DxvkContextFeature::DebugUtils))
+      m_features.set(DxvkContextFeature::AsyncCompute);
+
     // Create timeline semaphore for resource tracking IDs
     m_trackingFence = m_device->createFence(DxvkFenceCreateInfo());
 
@@ -847,6 +851,11 @@ namespace dxvk {
           uint32_t x,
           uint32_t y,
           uint32_t z) {
+    if (m_features.test(DxvkContextFeature::AsyncCompute) && this->canDispatchAsync()) {
+      this->dispatchAsync(x, y, z);
+      return;
+    }
+
     if (this->commitComputeState<false>()) {
       m_queryManager.beginQueries(m_cmd,
         VK_QUERY_TYPE_PIPELINE_STATISTICS);
@@ -7041,25 +7050,29 @@ namespace dxvk {
 
     if (likely(dirtySetMask)) {
       std::array<VkDescriptorSet, DxvkDescriptorSets::SetCount> sets = { };
-      m_descriptorPool->alloc(m_trackingId, pipelineLayout, dirtySetMask, sets.data());
 
       uint32_t descriptorCount = 0;
 
       for (auto setIndex : bit::BitMask(dirtySetMask)) {
         auto range = layout->getAllDescriptorsInSet(pipelineLayoutType, setIndex);
 
+        uint32_t firstDescriptor = descriptorCount;
+
         for (uint32_t j = 0; j < range.bindingCount; j++) {
           const auto& binding = range.bindings[j];
 
           if (!m_features.test(DxvkContextFeature::DescriptorTemplates)) {
             auto& descriptorWrite = m_legacyDescriptors.writes[descriptorCount];
-            descriptorWrite.dstSet = sets[setIndex];
             descriptorWrite.dstBinding = binding.getBinding();
             descriptorWrite.dstArrayElement = binding.getArrayIndex();
             descriptorWrite.descriptorType = binding.getDescriptorType();
           }
 
+          // The descriptor pool hashes and compares the raw union
+          // when looking up reusable sets, so clear any bytes that
+          // the type-specific code below does not overwrite.
           auto& descriptorInfo = m_legacyDescriptors.infos[descriptorCount++];
+          descriptorInfo = DxvkLegacyDescriptor();
 
           if (binding.isUniformBuffer()) {
             const auto& slice = m_uniformBuffers[binding.getResourceIndex()];
@@ -7199,16 +7212,29 @@ namespace dxvk {
           }
         }
 
-        if (m_features.test(DxvkContextFeature::DescriptorTemplates)) {
+        // Reuse an identical set from earlier in the submission if
+        // possible, otherwise write the newly allocated set.
+        const auto* setLayout = pipelineLayout->getDescriptorSetLayout(setIndex);
+
+        bool needsUpdate = m_descriptorPool->alloc(m_trackingId, setLayout,
+          descriptorCount - firstDescriptor, m_legacyDescriptors.infos.data() + firstDescriptor,
+          sets[setIndex]);
+
+        if (!needsUpdate) {
+          descriptorCount = firstDescriptor;
+        } else if (m_features.test(DxvkContextFeature::DescriptorTemplates)) {
           m_cmd->updateDescriptorSetWithTemplate(sets[setIndex],
-            pipelineLayout->getDescriptorSetLayout(setIndex)->getSetUpdateTemplate(),
+            setLayout->getSetUpdateTemplate(),
             m_legacyDescriptors.infos.data());
           descriptorCount = 0;
+        } else {
+          for (uint32_t j = firstDescriptor; j < descriptorCount; j++)
+            m_legacyDescriptors.writes[j].dstSet = sets[setIndex];
         }
       }
 
       // Update all descriptors in one go to avoid API call overhead
-      if (!m_features.test(DxvkContextFeature::DescriptorTemplates)) {
+      if (!m_features.test(DxvkContextFeature::DescriptorTemplates) && descriptorCount) {
         m_cmd->updateDescriptorSets(descriptorCount,
           m_legacyDescriptors.writes.data());
       }
@@ -8178,6 +8204,126 @@ namespace dxvk {
   }
 
 
+  bool DxvkContext::canDispatchAsync() {
+    // Pipeline statistics would not be gathered on the compute queue
+    if (m_queryManager.hasEnabledQueries(VK_QUERY_TYPE_PIPELINE_STATISTICS))
+      return false;
+
+    DxvkComputePipeline* pipeline = m_state.cp.pipeline;
+
+    if (!pipeline || m_flags.any(DxvkContextFlag::CpDirtyPipelineState,
+                                 DxvkContextFlag::CpDirtySpecConstants))
+      pipeline = lookupComputePipeline(m_state.cp.shaders);
+
+    if (!pipeline)
+      return false;
+
+    // Only consider dispatches that exclusively access buffers which have not
+    // been used in the current submission yet. Images are created with exclusive
+    // sharing and have layouts that we cannot track across queues, and anything
+    // that is used by prior commands would require cross-queue synchronization.
+    const DxvkPipelineBindings* layout = pipeline->getLayout();
+
+    auto readWrite = layout->getReadWriteResources();
+
+    if (!readWrite.bindingCount)
+      return false;
+
+    for (uint32_t i = 0u; i < readWrite.bindingCount; i++) {
+      if (!checkAsyncComputeBinding(readWrite.bindings[i]))
+        return false;
+    }
+
+    auto readOnly = layout->getReadOnlyResourcesForStage(VK_SHADER_STAGE_COMPUTE_BIT);
+
+    for (uint32_t i = 0u; i < readOnly.bindingCount; i++) {
+      if (!checkAsyncComputeBinding(readOnly.bindings[i]))
+        return false;
+    }
+
+    auto vaBindings = layout->getVaBindings(DxvkPipelineLayoutType::Merged);
+
+    for (uint32_t i = 0u; i < vaBindings.bindingCount; i++) {
+      if (!checkAsyncComputeBinding(vaBindings.bindings[i]))
+        return false;
+    }
+
+    return true;
+  }
+
+
+  bool DxvkContext::checkAsyncComputeBinding(
+    const DxvkShaderDescriptor&     binding) {
+    const DxvkBuffer* buffer = nullptr;
+
+    if (binding.isUniformBuffer()) {
+      const auto& slice = m_uniformBuffers[binding.getResourceIndex()];
+
+      if (!slice.length())
+        return true;
+
+      buffer = slice.buffer().ptr();
+    } else {
+      switch (binding.getDescriptorType()) {
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+        case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER: {
+          const auto& slot = m_resources[binding.getResourceIndex()];
+
+          if (!slot.bufferView)
+            return true;
+
+          buffer = slot.bufferView->buffer();
+        } break;
+
+        default:
+          return false;
+      }
+    }
+
+    // Sparse buffers may alias other resources
+    if (buffer->info().flags & VK_BUFFER_CREATE_SPARSE_BINDING_BIT)
+      return false;
+
+    // Checking for write access returns true for any prior use
+    return !buffer->isTracked(m_trackingId, DxvkAccess::Write);
+  }
+
+
+  void DxvkContext::dispatchAsync(
+          uint32_t                  x,
+          uint32_t                  y,
+          uint32_t                  z) {
+    // Any commands recorded so far must end up on the graphics queue
+    this->endRenderPass(false);
+    this->flushBarriers();
+
+    m_cmd->beginAsyncCompute();
+
+    // The async command buffer does not inherit any state
+    m_flags.set(DxvkContextFlag::CpDirtyPipelineState);
+    m_descriptorState.dirtyStages(VK_SHADER_STAGE_COMPUTE_BIT);
+
+    if (this->commitComputeState<false, false>()) {
+      m_cmd->cmdDispatch(DxvkCmdBuffer::ExecBuffer, x, y, z);
+      m_cmd->addStatCtr(DxvkStatCounter::CmdDispatchCalls, 1u);
+      m_cmd->addStatCtr(DxvkStatCounter::CmdDispatchAsyncCalls, 1u);
+    }
+
+    // Subsequent submissions wait for the compute queue, so
+    // barriers for the dispatch itself are not needed here
+    m_execBarriers.discardDeviceBarriers();
+    m_barrierTracker.clear();
+
+    m_cmd->endAsyncCompute();
+
+    // Start a new submission so that subsequent commands can
+    // be synchronized against the async dispatch via semaphore
+    this->splitCommands();
+  }
+
+
   template<bool Indirect, bool Resolve>
   bool DxvkContext::commitComputeState() {
     this->endRenderPass(false);
@@ -8385,6 +8531,9 @@ namespace dxvk {
     if (m_flags.test(DxvkContextFlag::DirtyDrawBuffer) && Indirect)
       this->trackDrawBuffer();
 
+    if (unlikely(m_flags.test(DxvkContextFlag::GpIndependentSets)))
+      m_cmd->addStatCtr(DxvkStatCounter::CmdDrawsUnoptimized, 1u);
+
     return true;
   }
   
@@ -10502,6 +10651,8 @@ namespace dxvk {
           DxvkCmdBuffer             cmdBuffer,
           size_t                    accessCount,
     const DxvkResourceAccess*       accessBatch) {
+    small_vector<DxvkBuffer*, 4> relocations;
+
     for (size_t i = 0u; i < accessCount; i++) {
       const auto& e = accessBatch[i];
 
@@ -10510,17 +10661,31 @@ namespace dxvk {
         : DxvkAccess::Read;
 
       if (e.buffer) {
+        bool relocate = false;
+
         cmdBuffer = prepareOutOfOrderTransfer(cmdBuffer,
-          *e.buffer, e.bufferOffset, e.bufferSize, access);
+          *e.buffer, e.bufferOffset, e.bufferSize, access, relocate);
+
+        if (relocate && std::find(relocations.begin(), relocations.end(), e.buffer) == relocations.end())
+          relocations.push_back(e.buffer);
       } else if (e.image) {
         cmdBuffer = prepareOutOfOrderTransfer(cmdBuffer,
           *e.image, e.imageSubresources, e.discard, access);
       }
 
       if (cmdBuffer == DxvkCmdBuffer::ExecBuffer)
-        break;
+        return cmdBuffer;
     }
 
+    // Only relocate buffers once we know that the transfer can actually be
+    // recorded outside of the current render pass, since doing so requires
+    // a new allocation and a full copy of the previous buffer contents.
+    for (auto buffer : relocations)
+      relocateBufferInRenderPass(*buffer);
+
+    if (!relocations.empty())
+      m_cmd->addStatCtr(DxvkStatCounter::CmdRenderPassesMerged, 1u);
+
     return cmdBuffer;
   }
 
@@ -10530,7 +10695,8 @@ namespace dxvk {
           DxvkBuffer&               buffer,
           VkDeviceSize              offset,
           VkDeviceSize              size,
-          DxvkAccess                access) {
+          DxvkAccess                access,
+          bool&                     relocate) {
     // Sparse resources can alias, need to ignore.
     if (unlikely(buffer.info().flags & VK_BUFFER_CREATE_SPARSE_BINDING_BIT))
       return DxvkCmdBuffer::ExecBuffer;
@@ -10561,9 +10727,18 @@ namespace dxvk {
     if (cmdBuffer < DxvkCmdBuffer::SdmaBuffer && !buffer.isTracked(m_trackingId, access))
       return cmdBuffer;
 
-    // Buffer is in use, now we *really* need to discard
-    if (!canDiscard)
-      return DxvkCmdBuffer::ExecBuffer;
+    // Buffer is in use, now we *really* need to discard. Partial writes can
+    // still be hoisted out of an active render pass by relocating the buffer
+    // and preserving its previous contents, which avoids splitting the pass.
+    // The caller performs the relocation once all accesses are known to be
+    // safe to record out of order.
+    if (!canDiscard) {
+      if (access != DxvkAccess::Write || !canRelocateBufferInRenderPass(buffer))
+        return DxvkCmdBuffer::ExecBuffer;
+
+      relocate = true;
+      return DxvkCmdBuffer::InitBuffer;
+    }
 
     // Ignore large buffers to keep memory overhead in check. Use a higher
     // threshold when a render pass is active to avoid interrupting it.
@@ -10593,6 +10768,74 @@ namespace dxvk {
   }
 
 
+  bool DxvkContext::canRelocateBufferInRenderPass(
+          DxvkBuffer&               buffer) {
+    if (!m_flags.test(DxvkContextFlag::GpRenderPassActive))
+      return false;
+
+    // We can only do this if the current backing storage has not been
+    // written in the current submission, since the copy is going to be
+    // executed before any commands recorded into the main command buffer.
+    if (!buffer.canRelocate() || buffer.isTracked(m_trackingId, DxvkAccess::Read))
+      return false;
+
+    if (buffer.info().size > MaxDiscardSizeInRp)
+      return false;
+
+    // Transform feedback buffers would require us to end the pass anyway
+    VkBufferUsageFlags xfbUsage = VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_COUNTER_BUFFER_BIT_EXT
+                                | VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_BUFFER_BIT_EXT;
+
+    return !(buffer.info().usage & xfbUsage);
+  }
+
+
+  void DxvkContext::relocateBufferInRenderPass(
+          DxvkBuffer&               buffer) {
+    // Copy previous buffer contents to the new backing storage. The old
+    // storage stays alive until the command list completes execution.
+    auto srcSlice = buffer.getSliceInfo();
+
+    this->invalidateBuffer(&buffer, buffer.allocateStorage());
+
+    auto dstSlice = buffer.getSliceInfo();
+
+    VkBufferCopy2 copyRegion = { VK_STRUCTURE_TYPE_BUFFER_COPY_2 };
+    copyRegion.srcOffset = srcSlice.offset;
+    copyRegion.dstOffset = dstSlice.offset;
+    copyRegion.size      = dstSlice.size;
+
+    VkCopyBufferInfo2 copyInfo = { VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2 };
+    copyInfo.srcBuffer = srcSlice.buffer;
+    copyInfo.dstBuffer = dstSlice.buffer;
+    copyInfo.regionCount = 1;
+    copyInfo.pRegions = &copyRegion;
+
+    m_cmd->cmdCopyBuffer(DxvkCmdBuffer::InitBuffer, &copyInfo);
+
+    // The actual transfer op will be recorded into the same command buffer
+    // right away, so we need to emit the barrier immediately rather than
+    // batching it up with the barriers emitted at the end of init commands.
+    VkMemoryBarrier2 barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER_2 };
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+
+    VkDependencyInfo depInfo = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+    depInfo.memoryBarrierCount = 1u;
+    depInfo.pMemoryBarriers = &barrier;
+
+    m_cmd->cmdPipelineBarrier(DxvkCmdBuffer::InitBuffer, &depInfo);
+
+    // Make the copied contents visible to subsequent commands even
+    // if the actual transfer op ends up in the main command buffer.
+    accessBuffer(DxvkCmdBuffer::InitBuffer, buffer, 0u, dstSlice.size,
+      VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+      DxvkAccessOp::None);
+  }
+
+
   DxvkCmdBuffer DxvkContext::prepareOutOfOrderTransfer(
           DxvkCmdBuffer             cmdBuffer,
           DxvkImage&                image,
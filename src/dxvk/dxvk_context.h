@@ -1785,6 +1785,16 @@ namespace dxvk {
     void beginComputePass();
     void endComputePass();
 
+    bool canDispatchAsync();
+
+    bool checkAsyncComputeBinding(
+      const DxvkShaderDescriptor&     binding);
+
+    void dispatchAsync(
+            uint32_t                  x,
+            uint32_t                  y,
+            uint32_t                  z);
+
     template<bool Indirect, bool Resolve = true>
     bool commitComputeState();
     
@@ -2169,7 +2179,14 @@ namespace dxvk {
             DxvkBuffer&               buffer,
             VkDeviceSize              offset,
             VkDeviceSize              size,
-            DxvkAccess                access);
+            DxvkAccess                access,
+            bool&                     relocate);
+
+    bool canRelocateBufferInRenderPass(
+            DxvkBuffer&               buffer);
+
+    void relocateBufferInRenderPass(
+            DxvkBuffer&               buffer);
 
     DxvkCmdBuffer prepareOutOfOrderTransfer(
             DxvkCmdBuffer             cmdBuffer,
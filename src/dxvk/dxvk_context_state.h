@@ -103,6 +103,7 @@ namespace dxvk {
     DescriptorBuffer,
     DescriptorHeap,
     DescriptorTemplates,
+    AsyncCompute,
     FeatureCount
   };
 
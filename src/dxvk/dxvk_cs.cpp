@@ -21,21 +21,21 @@ namespace dxvk {
     auto cmd = m_head;
     
     if (m_flags.test(DxvkCsChunkFlag::SingleUse)) {
-      m_commandOffset = 0;
-      
       while (cmd != nullptr) {
-        auto next = cmd->next();
-        cmd->exec(ctx);
-        cmd->~DxvkCsCmd();
+        auto next = getNext(cmd);
+        execCmd(ctx, cmd);
+        destroyCmd(cmd);
         cmd = next;
       }
 
+      m_commandOffset = 0;
+
       m_head = nullptr;
-      m_next = &m_head;
+      m_tail = nullptr;
     } else {
       while (cmd != nullptr) {
-        cmd->exec(ctx);
-        cmd = cmd->next();
+        execCmd(ctx, cmd);
+        cmd = getNext(cmd);
       }
     }
   }
@@ -45,16 +45,52 @@ namespace dxvk {
     auto cmd = m_head;
 
     while (cmd != nullptr) {
-      auto next = cmd->next();
-      cmd->~DxvkCsCmd();
+      auto next = getNext(cmd);
+      destroyCmd(cmd);
       cmd = next;
     }
     
     m_head = nullptr;
-    m_next = &m_head;
+    m_tail = nullptr;
 
     m_commandOffset = 0;
   }
+
+
+  void DxvkCsChunk::execCmd(DxvkContext* ctx, DxvkCsCmd* cmd) {
+    // Data records are stored directly after the command header
+    const void* op = cmd + 1;
+
+    switch (cmd->opcode()) {
+      case DxvkCsOpcode::Func:
+        static_cast<DxvkCsFuncCmd*>(cmd)->exec(ctx);
+        break;
+
+      case DxvkCsOpcode::SetBlendConstants:
+        ctx->setBlendConstants(reinterpret_cast<const DxvkCsSetBlendConstants*>(op)->constants);
+        break;
+
+      case DxvkCsOpcode::SetStencilReference:
+        ctx->setStencilReference(reinterpret_cast<const DxvkCsSetStencilReference*>(op)->reference);
+        break;
+
+      case DxvkCsOpcode::SetDepthBias:
+        ctx->setDepthBias(reinterpret_cast<const DxvkCsSetDepthBias*>(op)->depthBias);
+        break;
+
+      case DxvkCsOpcode::PushData: {
+        auto header = reinterpret_cast<const DxvkCsPushDataHeader*>(op);
+        ctx->pushData(header->stages, header->offset, header->size, header + 1);
+      } break;
+    }
+  }
+
+
+  void DxvkCsChunk::destroyCmd(DxvkCsCmd* cmd) {
+    // Data records are trivially destructible
+    if (cmd->opcode() == DxvkCsOpcode::Func)
+      static_cast<DxvkCsFuncCmd*>(cmd)->~DxvkCsFuncCmd();
+  }
   
   
   DxvkCsChunkPool::DxvkCsChunkPool() {
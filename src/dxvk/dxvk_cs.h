@@ -14,52 +14,185 @@ namespace dxvk {
 
   constexpr static size_t DxvkCsChunkSize = 16384;
 
+  /**
+   * \brief Command stream opcode
+   *
+   * Identifies how a recorded command is executed. Most
+   * commands store an arbitrary function object, but a
+   * few frequently used state updates are stored as plain
+   * data records which the worker decodes directly, which
+   * avoids the virtual call and the function object overhead.
+   */
+  enum class DxvkCsOpcode : uint32_t {
+    Func                = 0,
+    SetBlendConstants   = 1,
+    SetStencilReference = 2,
+    SetDepthBias        = 3,
+    PushData            = 4,
+  };
+
+
   /**
    * \brief Command stream operation
    * 
-   * An abstract representation of an operation
-   * that can be recorded into a command list.
+   * Header of any operation that can be recorded into
+   * a command list. Commands are linked via their offset
+   * within the chunk in order to keep the header small.
    */
   class DxvkCsCmd {
 
   public:
 
-    virtual ~DxvkCsCmd() { }
+    DxvkCsCmd(DxvkCsOpcode opcode)
+    : m_opcode(opcode) { }
 
     /**
-     * \brief Retrieves next command in a command chain
+     * \brief Retrieves command opcode
+     * \returns Command opcode
+     */
+    DxvkCsOpcode opcode() const {
+      return m_opcode;
+    }
+
+    /**
+     * \brief Retrieves offset of next command in the chunk
      *
-     * This can be used to quickly iterate
-     * over commands within a chunk.
-     * \returns Pointer the next command
+     * Since no command can follow the one at offset
+     * zero, an offset of zero terminates the chain.
+     * \returns Offset of the next command
      */
-    DxvkCsCmd* next() const {
+    uint32_t next() const {
       return m_next;
     }
 
     /**
-     * \brief Retrieves pointer to next chain
+     * \brief Sets offset of next command
      *
      * Used to chain commands.
-     * \returns Pointer the next command
+     * \param [in] next Offset of the next command
      */
-    DxvkCsCmd** chain() {
-      return &m_next;
+    void setNext(uint32_t next) {
+      m_next = next;
     }
 
+  private:
+
+    uint32_t      m_next = 0u;
+    DxvkCsOpcode  m_opcode;
+
+  };
+
+
+  /**
+   * \brief Function command
+   *
+   * Base class for commands that store a function
+   * object which is invoked on the worker thread.
+   */
+  class DxvkCsFuncCmd : public DxvkCsCmd {
+
+  public:
+
+    DxvkCsFuncCmd()
+    : DxvkCsCmd(DxvkCsOpcode::Func) { }
+
+    virtual ~DxvkCsFuncCmd() { }
+
     /**
      * \brief Executes embedded commands
      * \param [in] ctx The target context
      */
     virtual void exec(DxvkContext* ctx) = 0;
 
+  };
+
+
+  /**
+   * \brief Blend constant update
+   */
+  struct DxvkCsSetBlendConstants {
+    static constexpr DxvkCsOpcode Opcode = DxvkCsOpcode::SetBlendConstants;
+    DxvkBlendConstants  constants;
+  };
+
+
+  /**
+   * \brief Stencil reference update
+   */
+  struct DxvkCsSetStencilReference {
+    static constexpr DxvkCsOpcode Opcode = DxvkCsOpcode::SetStencilReference;
+    uint32_t            reference;
+  };
+
+
+  /**
+   * \brief Depth bias update
+   */
+  struct DxvkCsSetDepthBias {
+    static constexpr DxvkCsOpcode Opcode = DxvkCsOpcode::SetDepthBias;
+    DxvkDepthBias       depthBias;
+  };
+
+
+  /**
+   * \brief Push data update header
+   *
+   * The push data payload is stored
+   * immediately after the header.
+   */
+  struct DxvkCsPushDataHeader {
+    VkShaderStageFlags  stages;
+    uint32_t            offset;
+    uint32_t            size;
+  };
+
+
+  /**
+   * \brief Push data update
+   *
+   * Stores a copy of the given push data
+   * structure along with its location.
+   */
+  template<typename T>
+  struct DxvkCsPushData {
+    static constexpr DxvkCsOpcode Opcode = DxvkCsOpcode::PushData;
+    DxvkCsPushDataHeader header;
+    T                    data;
+  };
+
+
+  /**
+   * \brief Data command
+   *
+   * Stores a plain data record that is decoded by
+   * the chunk itself. The record must be trivially
+   * copyable and must directly follow the header.
+   */
+  template<typename T>
+  class DxvkCsOpCmd : public DxvkCsCmd {
+
+  public:
+
+    DxvkCsOpCmd(const T& op)
+    : DxvkCsCmd(T::Opcode), m_op(op) { }
+
   private:
 
-    DxvkCsCmd* m_next = nullptr;
+    T m_op;
 
   };
-  
-  
+
+
+  /**
+   * \brief Checks whether a command is a plain data record
+   */
+  template<typename T, typename = void>
+  struct DxvkCsIsOp : std::false_type { };
+
+  template<typename T>
+  struct DxvkCsIsOp<T, std::void_t<decltype(T::Opcode)>> : std::true_type { };
+
+
   /**
    * \brief Typed command
    * 
@@ -67,7 +200,7 @@ namespace dxvk {
    * used to execute an embedded command.
    */
   template<typename T>
-  class DxvkCsTypedCmd : public DxvkCsCmd {
+  class DxvkCsTypedCmd : public DxvkCsFuncCmd {
     
   public:
     
@@ -141,7 +274,7 @@ namespace dxvk {
    * submitting the command to a cs chunk.
    */
   template<typename T, typename M>
-  class DxvkCsDataCmd : public DxvkCsCmd {
+  class DxvkCsDataCmd : public DxvkCsFuncCmd {
 
   public:
 
@@ -214,21 +347,37 @@ namespace dxvk {
      * If the given command can be added to the chunk, it
      * will be consumed. Otherwise, a new chunk must be
      * created which is large enough to hold the command.
+     * Plain data records such as \ref DxvkCsSetBlendConstants
+     * are stored as-is and decoded without a virtual call.
      * \param [in] command The command to add
      * \returns \c true on success, \c false if
      *          a new chunk needs to be allocated
      */
     template<typename T>
     bool push(T& command) {
-      using FuncType = DxvkCsTypedCmd<T>;
-      void* ptr = alloc<FuncType>(0u);
+      if constexpr (DxvkCsIsOp<T>::value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        static_assert(alignof(T) <= alignof(DxvkCsCmd));
 
-      if (unlikely(!ptr))
-        return false;
+        using OpType = DxvkCsOpCmd<T>;
+        void* ptr = alloc<OpType>(0u);
 
-      auto next = new (ptr) FuncType(std::move(command));
-      append(next);
-      return true;
+        if (unlikely(!ptr))
+          return false;
+
+        append(new (ptr) OpType(command));
+        return true;
+      } else {
+        using FuncType = DxvkCsTypedCmd<T>;
+        void* ptr = alloc<FuncType>(0u);
+
+        if (unlikely(!ptr))
+          return false;
+
+        auto next = new (ptr) FuncType(std::move(command));
+        append(next);
+        return true;
+      }
     }
 
     template<typename T>
@@ -323,7 +472,7 @@ namespace dxvk {
     size_t m_commandOffset = 0;
     
     DxvkCsCmd*  m_head = nullptr;
-    DxvkCsCmd** m_next = &m_head;
+    DxvkCsCmd*  m_tail = nullptr;
 
     DxvkCsChunkFlags m_flags;
     
@@ -344,9 +493,25 @@ namespace dxvk {
     }
 
     void append(DxvkCsCmd* cmd) {
-      *m_next = cmd;
-      m_next = cmd->chain();
+      if (m_tail)
+        m_tail->setNext(uint32_t(reinterpret_cast<char*>(cmd) - m_data));
+      else
+        m_head = cmd;
+
+      m_tail = cmd;
     }
+
+    DxvkCsCmd* getNext(const DxvkCsCmd* cmd) {
+      uint32_t next = cmd->next();
+
+      return next
+        ? reinterpret_cast<DxvkCsCmd*>(&m_data[next])
+        : nullptr;
+    }
+
+    static void execCmd(DxvkContext* ctx, DxvkCsCmd* cmd);
+
+    static void destroyCmd(DxvkCsCmd* cmd);
     
   };
   
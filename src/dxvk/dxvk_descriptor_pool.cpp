@@ -1,3 +1,5 @@
+#include <cstring>
+
 #include "dxvk_descriptor_pool.h"
 #include "dxvk_device.h"
 
@@ -21,16 +23,6 @@ namespace dxvk {
   }
 
 
-  void DxvkDescriptorPool::alloc(
-          uint64_t                  trackingId,
-    const DxvkPipelineLayout*       layout,
-          uint32_t                  setMask,
-          VkDescriptorSet*          sets) {
-    for (auto setIndex : bit::BitMask(setMask))
-      sets[setIndex] = alloc(trackingId, layout->getDescriptorSetLayout(setIndex));
-  }
-
-
   VkDescriptorSet DxvkDescriptorPool::alloc(
           uint64_t                  trackingId,
     const DxvkDescriptorSetLayout*  layout) {
@@ -71,6 +63,52 @@ namespace dxvk {
   }
 
 
+  bool DxvkDescriptorPool::alloc(
+          uint64_t                  trackingId,
+    const DxvkDescriptorSetLayout*  layout,
+          uint32_t                  descriptorCount,
+    const DxvkLegacyDescriptor*     descriptors,
+          VkDescriptorSet&          set) {
+    VkDescriptorSetLayout setLayout = layout->getSetLayout();
+
+    if (trackingId != m_cacheTrackingId)
+      clearCache(trackingId);
+
+    size_t hash = hashDescriptors(setLayout, descriptorCount, descriptors);
+    auto range = m_cacheSets.equal_range(hash);
+
+    for (auto i = range.first; i != range.second; i++) {
+      const auto& entry = i->second;
+
+      if (entry.layout == setLayout && entry.descriptorCount == descriptorCount
+       && !std::memcmp(m_cacheDescriptors.data() + entry.descriptorIndex, descriptors,
+            sizeof(*descriptors) * descriptorCount)) {
+        set = entry.set;
+        return false;
+      }
+    }
+
+    // Allocating a new set may switch to a different pool, in
+    // which case previously cached sets must not be reused.
+    VkDescriptorPool pool = m_pool.second.pool;
+    set = alloc(trackingId, setLayout);
+
+    if (pool != m_pool.second.pool)
+      clearCache(trackingId);
+
+    CachedSet entry;
+    entry.layout = setLayout;
+    entry.set = set;
+    entry.descriptorIndex = m_cacheDescriptors.size();
+    entry.descriptorCount = descriptorCount;
+
+    m_cacheDescriptors.insert(m_cacheDescriptors.end(),
+      descriptors, descriptors + descriptorCount);
+    m_cacheSets.insert({ hash, entry });
+    return true;
+  }
+
+
   void DxvkDescriptorPool::notifyCompletion(
           uint64_t                    trackingId) {
     small_vector<std::pair<size_t, VkDescriptorPool>, 16u> pools;
@@ -167,4 +205,34 @@ namespace dxvk {
     return pool;
   }
 
+
+  void DxvkDescriptorPool::clearCache(
+          uint64_t                  trackingId) {
+    m_cacheTrackingId = trackingId;
+
+    m_cacheDescriptors.clear();
+    m_cacheSets.clear();
+  }
+
+
+  size_t DxvkDescriptorPool::hashDescriptors(
+          VkDescriptorSetLayout     layout,
+          uint32_t                  descriptorCount,
+    const DxvkLegacyDescriptor*     descriptors) {
+    static_assert(sizeof(DxvkLegacyDescriptor) % sizeof(uint64_t) == 0u);
+
+    DxvkHashState hash;
+    hash.add(uint64_t(layout));
+
+    for (uint32_t i = 0u; i < descriptorCount; i++) {
+      std::array<uint64_t, sizeof(DxvkLegacyDescriptor) / sizeof(uint64_t)> data;
+      std::memcpy(data.data(), &descriptors[i], sizeof(descriptors[i]));
+
+      for (auto dword : data)
+        hash.add(dword);
+    }
+
+    return hash;
+  }
+
 }
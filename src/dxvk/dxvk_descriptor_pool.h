@@ -1,5 +1,6 @@
 #pragma once
 
+#include <unordered_map>
 #include <vector>
 
 #include "dxvk_descriptor.h"
@@ -15,7 +16,8 @@ namespace dxvk {
    * \brief Descriptor pool
    *
    * Legacy descriptor pool allocator with submission-based lifetime
-   * tracking.
+   * tracking. Descriptor sets allocated with known contents can be
+   * reused within the same submission if the contents are identical.
    */
   class DxvkDescriptorPool : public RcObject {
     constexpr static uint32_t MaxDesiredPoolCount = 2;
@@ -26,18 +28,15 @@ namespace dxvk {
     ~DxvkDescriptorPool();
 
     /**
-     * \brief Allocates one or multiple descriptor sets
+     * \brief Allocates a single descriptor set
      *
      * \param [in] trackingId Submission tracking ID
-     * \param [in] layout Pipeline layout
-     * \param [in] setMask Descriptor set mask
-     * \param [out] sets Descriptor sets
+     * \param [in] layout Descriptor set layout
+     * \returns The descriptor set
      */
-    void alloc(
+    VkDescriptorSet alloc(
             uint64_t                  trackingId,
-      const DxvkPipelineLayout*       layout,
-            uint32_t                  setMask,
-            VkDescriptorSet*          sets);
+      const DxvkDescriptorSetLayout*  layout);
 
     /**
      * \brief Allocates a single descriptor set
@@ -48,18 +47,29 @@ namespace dxvk {
      */
     VkDescriptorSet alloc(
             uint64_t                  trackingId,
-      const DxvkDescriptorSetLayout*  layout);
+            VkDescriptorSetLayout     layout);
 
     /**
-     * \brief Allocates a single descriptor set
+     * \brief Allocates or reuses a descriptor set with given contents
      *
+     * If a set with the same layout and identical descriptors has been
+     * allocated from the current pool within the same submission, that
+     * set will be returned and does not need to be written again. All
+     * objects referenced by such a set are kept alive by the current
+     * command list, so reusing it is safe.
      * \param [in] trackingId Submission tracking ID
      * \param [in] layout Descriptor set layout
-     * \returns The descriptor set
+     * \param [in] descriptorCount Number of descriptors in the set
+     * \param [in] descriptors Descriptor infos in binding order
+     * \param [out] set The descriptor set
+     * \returns \c true if the set must be written by the caller
      */
-    VkDescriptorSet alloc(
+    bool alloc(
             uint64_t                  trackingId,
-            VkDescriptorSetLayout     layout);
+      const DxvkDescriptorSetLayout*  layout,
+            uint32_t                  descriptorCount,
+      const DxvkLegacyDescriptor*     descriptors,
+            VkDescriptorSet&          set);
 
     /**
      * \brief Declares given submission ID as complete
@@ -94,6 +104,18 @@ namespace dxvk {
       Status status = Status::Reset;
     };
 
+    struct CachedSet {
+      VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+      VkDescriptorSet set = VK_NULL_HANDLE;
+      uint32_t descriptorIndex = 0u;
+      uint32_t descriptorCount = 0u;
+    };
+
+    uint64_t m_cacheTrackingId = 0u;
+
+    std::vector<DxvkLegacyDescriptor>             m_cacheDescriptors;
+    std::unordered_multimap<size_t, CachedSet>    m_cacheSets;
+
     dxvk::mutex m_mutex;
 
     small_vector<DescriptorPool, 64u> m_pools;
@@ -103,6 +125,14 @@ namespace dxvk {
 
     VkDescriptorPool createDescriptorPool() const;
 
+    void clearCache(
+            uint64_t                  trackingId);
+
+    static size_t hashDescriptors(
+            VkDescriptorSetLayout     layout,
+            uint32_t                  descriptorCount,
+      const DxvkLegacyDescriptor*     descriptors);
+
   };
   
 }
@@ -42,10 +42,15 @@ namespace dxvk {
       m_shaderCache = DxvkShaderCache::getInstance();
 
     logBindingModel();
+
+    m_statsExporter = DxvkStatsExporter::createFromEnv(this);
   }
   
   
   DxvkDevice::~DxvkDevice() {
+    // Stop exporting statistics before tearing anything down
+    m_statsExporter = nullptr;
+
     if (m_kmtLocal) {
       D3DKMT_DESTROYDEVICE destroy = { };
       destroy.hDevice = m_kmtLocal;
@@ -140,6 +145,10 @@ namespace dxvk {
 
       default:
       case Tristate::Auto:
+        // Pipeline eviction relies on lifetime tracking to work
+        if (m_options.maxOptimizedPipelines && canUseGraphicsPipelineLibrary())
+          return true;
+
         if (!env::is32BitHostPlatform() || !canUseGraphicsPipelineLibrary())
           return false;
 
@@ -504,14 +513,18 @@ namespace dxvk {
   DxvkStatCounters DxvkDevice::getStatCounters() {
     DxvkPipelineCount pipe = m_objects.pipelineManager().getPipelineCount();
     DxvkPipelineWorkerStats workers = m_objects.pipelineManager().getWorkerStats();
-    
+    DxvkSubmissionStats submissions = m_submissionQueue.getStatistics();
+
     DxvkStatCounters result;
     result.setCtr(DxvkStatCounter::PipeCountGraphics, pipe.numGraphicsPipelines);
     result.setCtr(DxvkStatCounter::PipeCountLibrary,  pipe.numGraphicsLibraries);
     result.setCtr(DxvkStatCounter::PipeCountCompute,  pipe.numComputePipelines);
+    result.setCtr(DxvkStatCounter::PipeCountOptimized, pipe.numOptimizedPipelines);
+    result.setCtr(DxvkStatCounter::PipeCountEvicted,  pipe.numEvictedPipelines);
     result.setCtr(DxvkStatCounter::PipeTasksDone,     workers.tasksCompleted);
     result.setCtr(DxvkStatCounter::PipeTasksTotal,    workers.tasksTotal);
-    result.setCtr(DxvkStatCounter::GpuIdleTicks,      m_submissionQueue.gpuIdleTicks());
+    result.setCtr(DxvkStatCounter::QueueSubmitCount,  submissions.queueSubmitCount);
+    result.setCtr(DxvkStatCounter::GpuIdleTicks,      submissions.gpuIdleTicks);
 
     std::lock_guard<sync::Spinlock> lock(m_statLock);
     result.merge(m_statCounters);
@@ -616,8 +629,12 @@ namespace dxvk {
 
     m_submissionQueue.present(presentInfo, latencyInfo, status);
     
-    std::lock_guard<sync::Spinlock> statLock(m_statLock);
-    m_statCounters.addCtr(DxvkStatCounter::QueuePresentCount, 1);
+    { std::lock_guard<sync::Spinlock> statLock(m_statLock);
+      m_statCounters.addCtr(DxvkStatCounter::QueuePresentCount, 1);
+    }
+
+    if (m_statsExporter)
+      m_statsExporter->notifyPresent(tracker, frameId);
   }
 
 
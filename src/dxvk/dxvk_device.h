@@ -24,6 +24,7 @@
 #include "dxvk_shader.h"
 #include "dxvk_sparse.h"
 #include "dxvk_stats.h"
+#include "dxvk_stats_export.h"
 #include "dxvk_unbound.h"
 
 namespace dxvk {
@@ -69,6 +70,7 @@ namespace dxvk {
     DxvkDeviceQueue graphics;
     DxvkDeviceQueue transfer;
     DxvkDeviceQueue sparse;
+    DxvkDeviceQueue compute;
   };
   
   /**
@@ -172,14 +174,27 @@ namespace dxvk {
           != m_queues.graphics.queueHandle;
     }
 
+    /**
+     * \brief Tests whether an async compute queue is available
+     * \returns \c true if compute work can be submitted to a
+     *    dedicated queue that runs alongside graphics work
+     */
+    bool hasAsyncComputeQueue() const {
+      return m_queues.compute.queueHandle != VK_NULL_HANDLE;
+    }
+
     /**
      * \brief Queries sharing mode info
      * \returns Sharing mode info
      */
     DxvkSharingModeInfo getSharingMode() const {
       DxvkSharingModeInfo result = { };
-      result.queueFamilies[0] = m_queues.graphics.queueFamily;
-      result.queueFamilies[1] = m_queues.transfer.queueFamily;
+      result.addQueueFamily(m_queues.graphics.queueFamily);
+      result.addQueueFamily(m_queues.transfer.queueFamily);
+
+      if (m_queues.compute.queueHandle)
+        result.addQueueFamily(m_queues.compute.queueFamily);
+
       return result;
     }
 
@@ -547,6 +562,17 @@ namespace dxvk {
      */
     DxvkStatCounters getStatCounters();
 
+    /**
+     * \brief Retrieves submission statistics
+     *
+     * Cheap to query, and meant to be used for
+     * feedback-driven submission heuristics.
+     * \returns Submission statistics
+     */
+    DxvkSubmissionStats getSubmissionStats() const {
+      return m_submissionQueue.getStatistics();
+    }
+
     /**
      * \brief Queries memory statistics
      *
@@ -774,6 +800,8 @@ namespace dxvk {
 
     Rc<DxvkShaderCache>         m_shaderCache;
 
+    std::unique_ptr<DxvkStatsExporter> m_statsExporter;
+
     DxvkDevicePerfHints getPerfHints();
 
     void recycleCommandList(
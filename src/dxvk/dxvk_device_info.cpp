@@ -118,7 +118,7 @@ namespace dxvk {
     disableUnusedFeatures(instance, safeMode);
 
     enableFeaturesAndExtensions();
-    enableQueues();
+    enableQueues(instance);
   }
 
 
@@ -214,7 +214,8 @@ namespace dxvk {
     stream << "Queues:" << std::endl
            << "  Graphics : (" << m_queueMapping.graphics.family << ", " << m_queueMapping.graphics.index << ")" << std::endl
            << "  Transfer : (" << m_queueMapping.transfer.family << ", " << m_queueMapping.transfer.index << ")" << std::endl
-           << "  Sparse   : (" << m_queueMapping.sparse.family   << ", " << m_queueMapping.sparse.index   << ")" << std::endl;
+           << "  Sparse   : (" << m_queueMapping.sparse.family   << ", " << m_queueMapping.sparse.index   << ")" << std::endl
+           << "  Compute  : (" << m_queueMapping.compute.family  << ", " << m_queueMapping.compute.index  << ")" << std::endl;
 
     // Log memory type and heap properties
     static const std::array<std::pair<VkMemoryPropertyFlagBits, const char*>, 8> s_flags = {{
@@ -659,7 +660,8 @@ namespace dxvk {
   }
 
 
-  void DxvkDeviceCapabilities::enableQueues() {
+  void DxvkDeviceCapabilities::enableQueues(
+    const DxvkInstance&               instance) {
     m_queueMapping.graphics.family = findQueueFamily(
       VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT,
       VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
@@ -692,10 +694,21 @@ namespace dxvk {
         VK_QUEUE_SPARSE_BINDING_BIT);
     }
 
+    // Only use a separate compute queue if it is from a dedicated
+    // family, and try not to share a queue with transfer work.
+    if (instance.options().enableAsyncCompute && computeQueue != m_queueMapping.graphics.family) {
+      m_queueMapping.compute.family = computeQueue;
+
+      if (computeQueue == m_queueMapping.transfer.family
+       && m_queuesAvailable[computeQueue].core.queueFamilyProperties.queueCount > 1u)
+        m_queueMapping.compute.index = 1u;
+    }
+
     // Actually enable all the queues
     enableQueue(m_queueMapping.graphics);
     enableQueue(m_queueMapping.transfer);
     enableQueue(m_queueMapping.sparse);
+    enableQueue(m_queueMapping.compute);
 
     // Fix up queue priority pointers
     uint32_t maxQueueCount = 0u;
@@ -717,7 +730,7 @@ namespace dxvk {
 
     for (auto& q : m_queuesEnabled) {
       if (q.queueFamilyIndex == queue.family) {
-        q.queueCount = queue.index + 1u;
+        q.queueCount = std::max(q.queueCount, queue.index + 1u);
         return;
       }
     }
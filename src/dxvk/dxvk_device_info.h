@@ -221,6 +221,7 @@ namespace dxvk {
     DxvkDeviceQueueIndex graphics;
     DxvkDeviceQueueIndex transfer;
     DxvkDeviceQueueIndex sparse;
+    DxvkDeviceQueueIndex compute;
   };
 
 
@@ -427,7 +428,8 @@ namespace dxvk {
 
     void enableFeaturesAndExtensions();
 
-    void enableQueues();
+    void enableQueues(
+      const DxvkInstance&               instance);
 
     void enableQueue(
             DxvkDeviceQueueIndex        queue);
@@ -428,6 +428,17 @@ namespace dxvk {
       const Rc<DxvkCommandList>&  cmd,
             VkQueryType           type);
 
+    /**
+     * \brief Checks whether any queries of a given type are enabled
+     *
+     * \param [in] type Query type
+     * \returns \c true if any query of the given type is enabled
+     */
+    bool hasEnabledQueries(
+            VkQueryType           type) const {
+      return !m_activeQueries[getQueryTypeIndex(type, 0u)].queries.empty();
+    }
+
   private:
 
     struct QuerySet {
@@ -1112,7 +1112,21 @@ namespace dxvk {
       }
     }
 
-    return instance->getHandle();
+    DxvkGraphicsPipelineHandle handle = instance->getHandle();
+
+    if (unlikely(instance->isEvicted.load()))
+      handle = this->restoreInstance(state, instance);
+
+    // If a base pipeline gets used a lot, move its optimized variant ahead of
+    // all other pending low-priority work. The original work item will exit
+    // early once either of the two has started compiling the pipeline.
+    if (unlikely(handle.type == DxvkGraphicsPipelineType::BasePipeline)) {
+      if (instance->useCount.fetch_add(1u) + 1u == HotInstanceUseCount
+       && !instance->isCompiling.load())
+        m_workers->compileGraphicsPipeline(this, state, DxvkPipelinePriority::Normal);
+    }
+
+    return handle;
   }
 
 
@@ -1175,16 +1189,15 @@ namespace dxvk {
 
     std::unique_lock<dxvk::mutex> lock(m_mutex);
 
-    if (!(--m_useCount)) {
-      // Don't destroy base pipelines if that's all we're going to
-      // use, since that would pretty much ruin the experience.
-      if (m_device->config().enableGraphicsPipelineLibrary == Tristate::True)
-        return;
+    if (--m_useCount)
+      return;
 
-      // Exit early if there's nothing to do
-      if (m_basePipelines.empty())
-        return;
+    m_idleFrameId.store(m_device->getCurrentFrameId());
 
+    // Don't destroy base pipelines if that's all we're going to
+    // use, since that would pretty much ruin the experience.
+    if (m_device->config().enableGraphicsPipelineLibrary != Tristate::True
+     && !m_basePipelines.empty()) {
       // Remove any base pipeline references, but
       // keep the optimized pipelines around.
       m_pipelines.forEach([] (DxvkGraphicsPipelineInstance& e) {
@@ -1194,6 +1207,46 @@ namespace dxvk {
       // Destroy the actual Vulkan pipelines
       this->destroyBasePipelines();
     }
+
+    // Notify the pipeline manager without holding the lock,
+    // since it may evict optimized pipelines of any pipeline
+    lock.unlock();
+
+    m_manager->notifyPipelineIdle(this);
+  }
+
+
+  bool DxvkGraphicsPipeline::evictOptimizedPipelines() {
+    std::unique_lock<dxvk::mutex> lock(m_mutex);
+
+    if (m_useCount || m_fastPipelines.empty())
+      return false;
+
+    // Only evict pipelines whose instances can all be recreated from
+    // pipeline libraries, otherwise we would have to compile optimized
+    // pipelines synchronously on the next draw.
+    bool canEvict = true;
+
+    m_pipelines.forEachEntry([this, &canEvict] (
+        const DxvkGraphicsPipelineStateInfo&  state,
+        const DxvkGraphicsPipelineInstance&   /* instance */) {
+      canEvict = canEvict && this->canCreateBasePipeline(state);
+    });
+
+    if (!canEvict)
+      return false;
+
+    m_pipelines.forEach([] (DxvkGraphicsPipelineInstance& e) {
+      e.fastHandle.store(VK_NULL_HANDLE);
+      e.isCompiling.store(VK_FALSE);
+      e.isEvicted.store(VK_TRUE);
+      e.useCount.store(0u);
+    });
+
+    m_stats->numEvictedPipelines += m_fastPipelines.size();
+
+    this->destroyOptimizedPipelines();
+    return true;
   }
 
 
@@ -1223,6 +1276,40 @@ namespace dxvk {
     const DxvkGraphicsPipelineStateInfo& state) {
     return m_pipelines.find(state);
   }
+
+
+  DxvkGraphicsPipelineHandle DxvkGraphicsPipeline::restoreInstance(
+    const DxvkGraphicsPipelineStateInfo& state,
+          DxvkGraphicsPipelineInstance*  instance) {
+    std::unique_lock<dxvk::mutex> lock(m_mutex);
+
+    // Another thread may have restored the instance already, or a worker
+    // may have compiled the optimized pipeline in the meantime
+    if (!instance->isEvicted.load() || instance->fastHandle.load()) {
+      instance->isEvicted.store(VK_FALSE);
+      return instance->getHandle();
+    }
+
+    VkPipeline baseHandle = instance->baseHandle.load();
+
+    if (!baseHandle) {
+      baseHandle = this->getBasePipeline(state);
+      instance->baseHandle.store(baseHandle);
+    }
+
+    if (!baseHandle) {
+      instance->isCompiling.store(VK_TRUE);
+      instance->fastHandle.store(this->getOptimizedPipeline(state));
+    }
+
+    instance->isEvicted.store(VK_FALSE);
+    lock.unlock();
+
+    if (baseHandle)
+      m_workers->compileGraphicsPipeline(this, state, DxvkPipelinePriority::Low);
+
+    return instance->getHandle();
+  }
   
   
   bool DxvkGraphicsPipeline::canCreateBasePipeline(
@@ -1420,6 +1507,9 @@ namespace dxvk {
       // so that other threads can safely read the pipeline handle.
       auto [status, handle] = createOptimizedPipeline(key);
 
+      if (handle)
+        m_stats->numOptimizedPipelines += 1;
+
       entry.first->second.pipeline = handle;
       entry.first->second.status.store(status);
 
@@ -1534,8 +1624,14 @@ namespace dxvk {
 
 
   void DxvkGraphicsPipeline::destroyOptimizedPipelines() {
-    for (const auto& instance : m_fastPipelines)
+    std::unique_lock lock(m_fastMutex);
+
+    for (const auto& instance : m_fastPipelines) {
+      if (instance.second.pipeline)
+        m_stats->numOptimizedPipelines -= 1;
+
       this->destroyVulkanPipeline(instance.second.pipeline);
+    }
 
     m_fastPipelines.clear();
   }
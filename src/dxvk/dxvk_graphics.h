@@ -373,6 +373,8 @@ namespace dxvk {
     std::atomic<VkPipeline>       baseHandle  = { VK_NULL_HANDLE };
     std::atomic<VkPipeline>       fastHandle  = { VK_NULL_HANDLE };
     std::atomic<VkBool32>         isCompiling = { VK_FALSE };
+    std::atomic<VkBool32>         isEvicted   = { VK_FALSE };
+    std::atomic<uint32_t>         useCount    = { 0u };
     DxvkAttachmentMask            attachments = { };
 
     DxvkGraphicsPipelineHandle getHandle() const {
@@ -498,7 +500,9 @@ namespace dxvk {
    * pipeline state vector.
    */
   class DxvkGraphicsPipeline {
-    
+    // Number of times a base pipeline instance needs to be bound
+    // before its optimized variant gets compiled with priority
+    constexpr static uint32_t HotInstanceUseCount = 16u;
   public:
     
     DxvkGraphicsPipeline(
@@ -563,6 +567,8 @@ namespace dxvk {
      * 
      * Retrieves a pipeline handle for the given pipeline
      * state. If necessary, a new pipeline will be created.
+     * Base pipelines that are used frequently will have their
+     * optimized variant compiled with a higher priority.
      * \param [in] state Pipeline state vector
      * \returns Pipeline handle and handle type
      */
@@ -596,6 +602,24 @@ namespace dxvk {
      */
     void releasePipeline();
 
+    /**
+     * \brief Queries frame ID at which the pipeline became unused
+     * \returns Frame ID of the last release
+     */
+    uint32_t getIdleFrameId() const {
+      return m_idleFrameId.load();
+    }
+
+    /**
+     * \brief Evicts optimized pipelines
+     *
+     * Destroys all optimized Vulkan pipelines if the pipeline is
+     * not currently in use. Affected instances will be recreated
+     * from pipeline libraries the next time they are used.
+     * \returns \c true if pipelines were evicted
+     */
+    bool evictOptimizedPipelines();
+
     /**
      * \brief Queries debug name for the pipeline
      *
@@ -635,6 +659,7 @@ namespace dxvk {
       DxvkGraphicsPipelineStateInfo,
       DxvkGraphicsPipelineInstance>               m_pipelines;
     uint32_t                                      m_useCount = 0;
+    std::atomic<uint32_t>                         m_idleFrameId = { 0u };
 
     std::unordered_map<
       DxvkGraphicsPipelineBaseInstanceKey,
@@ -654,6 +679,10 @@ namespace dxvk {
     DxvkGraphicsPipelineInstance* findInstance(
       const DxvkGraphicsPipelineStateInfo& state);
 
+    DxvkGraphicsPipelineHandle restoreInstance(
+      const DxvkGraphicsPipelineStateInfo& state,
+            DxvkGraphicsPipelineInstance*  instance);
+
     bool canCreateBasePipeline(
       const DxvkGraphicsPipelineStateInfo& state) const;
 
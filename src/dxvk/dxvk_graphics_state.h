@@ -896,6 +896,11 @@ namespace dxvk {
       iter(m_table, [&] (Entry* e) { fn(e->value); });
     }
 
+    template<typename Fn>
+    void forEachEntry(const Fn& fn) const {
+      iter(m_table, [&] (Entry* e) { fn(e->key, e->value); });
+    }
+
   private:
 
     struct Entry;
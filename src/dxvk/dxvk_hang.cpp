@@ -148,6 +148,10 @@ namespace dxvk {
 
     if (m_device->features().khrDeviceFault.deviceFaultVendorBinary)
       dumpDeviceFaultInfo();
+
+    // The process is likely going to die soon, make
+    // sure that all relevant info ends up on disk
+    Logger::flush();
   }
 
 
@@ -15,10 +15,20 @@ namespace dxvk {
 
   /**
    * \brief Latency tracker statistics
+   *
+   * The per-stage times break down where a frame spent its time:
+   * CPU time until the first submission, CS thread recording time,
+   * GPU execution time, and the time from GPU completion to the
+   * frame being presented. Stages that a tracker does not measure
+   * are reported as zero.
    */
   struct DxvkLatencyStats {
     std::chrono::microseconds frameLatency;
     std::chrono::microseconds sleepDuration;
+    std::chrono::microseconds cpuTime;
+    std::chrono::microseconds csTime;
+    std::chrono::microseconds gpuTime;
+    std::chrono::microseconds presentDelay;
   };
 
 
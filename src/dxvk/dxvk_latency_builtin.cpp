@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 
 #include "dxvk_latency_builtin.h"
@@ -54,6 +55,13 @@ namespace dxvk {
 
   void DxvkBuiltInLatencyTracker::notifyCsRenderBegin(
           uint64_t                  frameId) {
+    { std::unique_lock lock(m_mutex);
+      auto frame = findFrame(frameId);
+
+      if (frame)
+        frame->cpuRenderBegin = dxvk::high_resolution_clock::now();
+    }
+
     if (forwardLatencyMarkerNv(frameId)) {
       m_presenter->setLatencyMarkerNv(frameId, VK_LATENCY_MARKER_SIMULATION_END_NV);
       m_presenter->setLatencyMarkerNv(frameId, VK_LATENCY_MARKER_RENDERSUBMIT_START_NV);
@@ -63,6 +71,13 @@ namespace dxvk {
 
   void DxvkBuiltInLatencyTracker::notifyCsRenderEnd(
           uint64_t                  frameId) {
+    { std::unique_lock lock(m_mutex);
+      auto frame = findFrame(frameId);
+
+      if (frame)
+        frame->cpuRenderEnd = dxvk::high_resolution_clock::now();
+    }
+
     if (forwardLatencyMarkerNv(frameId))
       m_presenter->setLatencyMarkerNv(frameId, VK_LATENCY_MARKER_RENDERSUBMIT_END_NV);
   }
@@ -173,6 +188,7 @@ namespace dxvk {
   void DxvkBuiltInLatencyTracker::discardTimings() {
     std::unique_lock lock(m_mutex);
     m_validRangeBegin = m_validRangeEnd + 1u;
+    m_historyCount = 0u;
   }
 
 
@@ -188,6 +204,17 @@ namespace dxvk {
       if (f && f->frameEnd != time_point()) {
         stats.frameLatency = std::chrono::duration_cast<std::chrono::microseconds>(f->frameEnd - f->frameStart);
         stats.sleepDuration = std::chrono::duration_cast<std::chrono::microseconds>(f->sleepDuration);
+
+        if (f->queueSubmit != time_point())
+          stats.cpuTime = std::chrono::duration_cast<std::chrono::microseconds>(f->queueSubmit - f->frameStart);
+
+        if (f->cpuRenderBegin != time_point() && f->cpuRenderEnd != time_point())
+          stats.csTime = std::chrono::duration_cast<std::chrono::microseconds>(f->cpuRenderEnd - f->cpuRenderBegin);
+
+        if (f->gpuExecStart != time_point() && f->gpuExecEnd != time_point()) {
+          stats.gpuTime = std::chrono::duration_cast<std::chrono::microseconds>(f->gpuExecEnd - f->gpuExecStart - f->gpuIdleTime);
+          stats.presentDelay = std::chrono::duration_cast<std::chrono::microseconds>(f->frameEnd - f->gpuExecEnd);
+        }
         break;
       }
     }
@@ -291,8 +318,30 @@ namespace dxvk {
       gpuTimes[i] = (f->gpuExecEnd - f->gpuExecStart) - f->gpuIdleTime;
     }
 
-    duration nextCpuTime = estimateTime(cpuTimes.data(), cpuTimes.size());
-    duration nextGpuTime = estimateTime(gpuTimes.data(), gpuTimes.size());
+    // Add the most recently completed frame to the history, and once we
+    // have seen enough frames, use a high percentile over the history to
+    // estimate CPU and GPU times. This is more stable than looking at the
+    // last few frames only, and still reacts to sustained changes.
+    if (prev->frameId > m_historyFrameId) {
+      m_cpuTimeHistory[m_historyCount % HistorySize] = cpuTimes[0];
+      m_gpuTimeHistory[m_historyCount % HistorySize] = gpuTimes[0];
+
+      m_historyFrameId = prev->frameId;
+      m_historyCount += 1u;
+    }
+
+    duration nextCpuTime = duration(0u);
+    duration nextGpuTime = duration(0u);
+
+    if (m_historyCount >= HistorySize / 4u) {
+      size_t count = std::min<size_t>(m_historyCount, HistorySize);
+
+      nextCpuTime = estimatePercentile(m_cpuTimeHistory.data(), count, 90u);
+      nextGpuTime = estimatePercentile(m_gpuTimeHistory.data(), count, 90u);
+    } else {
+      nextCpuTime = estimateTime(cpuTimes.data(), cpuTimes.size());
+      nextGpuTime = estimateTime(gpuTimes.data(), gpuTimes.size());
+    }
 
     // Compute the initial deadline based on GPU execution times
     time_point gpuDeadline = prev->gpuExecEnd + 2u * nextGpuTime;
@@ -406,4 +455,18 @@ namespace dxvk {
 
     return result;
   }
+
+
+  DxvkBuiltInLatencyTracker::duration DxvkBuiltInLatencyTracker::estimatePercentile(
+    const duration*                 frames,
+          size_t                    frameCount,
+          uint32_t                  percentile) {
+    std::array<duration, HistorySize> sorted = { };
+    std::copy(frames, frames + frameCount, sorted.begin());
+
+    size_t index = (frameCount * percentile) / 100u;
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.begin() + frameCount);
+    return sorted[index];
+  }
+
 }
@@ -27,6 +27,7 @@ namespace dxvk {
     using duration = typename DxvkLatencyFrameData::duration;
 
     constexpr static size_t FrameCount = 8u;
+    constexpr static size_t HistorySize = 64u;
   public:
 
     DxvkBuiltInLatencyTracker(
@@ -95,6 +96,12 @@ namespace dxvk {
     uint64_t m_validRangeBegin = 0u;
     uint64_t m_validRangeEnd = 0u;
 
+    std::array<duration, HistorySize> m_cpuTimeHistory = { };
+    std::array<duration, HistorySize> m_gpuTimeHistory = { };
+
+    uint64_t m_historyFrameId = 0u;
+    uint32_t m_historyCount = 0u;
+
     duration sleepNv(
             uint64_t                  frameId,
             double                    maxFrameRate);
@@ -122,6 +129,11 @@ namespace dxvk {
       const duration*                 frames,
             size_t                    frameCount);
 
+    static duration estimatePercentile(
+      const duration*                 frames,
+            size_t                    frameCount,
+            uint32_t                  percentile);
+
   };
 
 }
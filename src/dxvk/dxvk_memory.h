@@ -232,10 +232,20 @@ namespace dxvk {
    * to fill in sharing mode infos for resource creation.
    */
   struct DxvkSharingModeInfo {
-    std::array<uint32_t, 2u> queueFamilies = { };
+    std::array<uint32_t, 3u> queueFamilies = { };
+    uint32_t queueFamilyCount = 0u;
+
+    void addQueueFamily(uint32_t family) {
+      for (uint32_t i = 0u; i < queueFamilyCount; i++) {
+        if (queueFamilies[i] == family)
+          return;
+      }
+
+      queueFamilies[queueFamilyCount++] = family;
+    }
 
     VkSharingMode sharingMode() const {
-      return queueFamilies[0] != queueFamilies[1]
+      return queueFamilyCount > 1u
         ? VK_SHARING_MODE_CONCURRENT
         : VK_SHARING_MODE_EXCLUSIVE;
     }
@@ -245,7 +255,7 @@ namespace dxvk {
       info.sharingMode = sharingMode();
 
       if (info.sharingMode == VK_SHARING_MODE_CONCURRENT) {
-        info.queueFamilyIndexCount = queueFamilies.size();
+        info.queueFamilyIndexCount = queueFamilyCount;
         info.pQueueFamilyIndices = queueFamilies.data();
       }
     }
@@ -13,7 +13,10 @@ namespace dxvk {
     enableUnifiedImageLayout = config.getOption<bool> ("dxvk.enableUnifiedImageLayouts", true);
     enableImplicitResolves = config.getOption<bool>   ("dxvk.enableImplicitResolves", true);
     enableNvRawAccessChains = config.getOption<bool>  ("dxvk.enableNvRawAccessChains", true);
+    enableAsyncCompute    = config.getOption<bool>    ("dxvk.enableAsyncCompute",     false);
     trackPipelineLifetime = config.getOption<Tristate>("dxvk.trackPipelineLifetime",  Tristate::Auto);
+    maxOptimizedPipelines = uint32_t(std::max(config.getOption<int32_t>("dxvk.maxOptimizedPipelines", 0), 0));
+    pipelineEvictionFrames = uint32_t(std::max(config.getOption<int32_t>("dxvk.pipelineEvictionFrames", 3600), 0));
     useRawSsbo            = config.getOption<Tristate>("dxvk.useRawSsbo",             Tristate::Auto);
     hud                   = config.getOption<std::string>("dxvk.hud", "");
     tearFree              = config.getOption<Tristate>("dxvk.tearFree",               Tristate::Auto);
@@ -23,10 +26,14 @@ namespace dxvk {
     hideIntegratedGraphics = config.getOption<bool>   ("dxvk.hideIntegratedGraphics", false);
     zeroMappedMemory      = config.getOption<bool>    ("dxvk.zeroMappedMemory",       false);
     allowFse              = config.getOption<bool>    ("dxvk.allowFse",               false);
+    asyncAcquire          = config.getOption<bool>    ("dxvk.asyncAcquire",           false);
     deviceFilter          = config.getOption<std::string>("dxvk.deviceFilter",        "");
     lowerSinCos           = config.getOption<Tristate>("dxvk.lowerSinCos",            Tristate::Auto);
     tilerMode             = config.getOption<Tristate>("dxvk.tilerMode",              Tristate::Auto);
 
+    std::string flushModeStr = Config::toLower(config.getOption<std::string>("dxvk.flushMode", "static"));
+    flushMode = flushModeStr == "adaptive" ? GpuFlushMode::Adaptive : GpuFlushMode::Static;
+
     auto budget = config.getOption<int32_t>("dxvk.maxMemoryBudget", 0);
     maxMemoryBudget = VkDeviceSize(std::max(budget, 0)) << 20u;
   }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../util/config/config.h"
+#include "../util/util_flush.h"
 #include "../util/util_env.h"
 
 #include "../vulkan/vulkan_loader.h"
@@ -36,6 +37,14 @@ namespace dxvk {
     /// Enables pipeline lifetime tracking
     Tristate trackPipelineLifetime = Tristate::Auto;
 
+    /// Maximum number of optimized graphics pipelines
+    /// to keep alive before evicting unused ones
+    uint32_t maxOptimizedPipelines = 0u;
+
+    /// Number of frames an optimized graphics pipeline
+    /// must be unused for before it can be evicted
+    uint32_t pipelineEvictionFrames = 0u;
+
     /// Shader-related options
     Tristate useRawSsbo = Tristate::Auto;
 
@@ -67,9 +76,16 @@ namespace dxvk {
     /// Allows full-screen exclusive mode on Windows
     bool allowFse = false;
 
+    /// Acquires the next swap chain image on a dedicated
+    /// thread rather than the submission thread
+    bool asyncAcquire = false;
+
     /// Whether to enable tiler optimizations
     Tristate tilerMode = Tristate::Auto;
 
+    /// Context flush heuristic to use
+    GpuFlushMode flushMode = GpuFlushMode::Static;
+
     /// Overrides memory budget for DXVK
     VkDeviceSize maxMemoryBudget = 0u;
 
@@ -86,6 +102,9 @@ namespace dxvk {
     /// Enable descriptor update templates
     bool enableDescriptorUpdateTemplates = env::is32BitHostPlatform();
 
+    /// Enables dedicated async compute queue
+    bool enableAsyncCompute = false;
+
     /// Device name
     std::string deviceFilter;
   };
@@ -334,10 +334,46 @@ namespace dxvk {
     result.numGraphicsPipelines = m_stats.numGraphicsPipelines.load();
     result.numGraphicsLibraries = m_stats.numGraphicsLibraries.load();
     result.numComputePipelines  = m_stats.numComputePipelines.load();
+    result.numOptimizedPipelines = m_stats.numOptimizedPipelines.load();
+    result.numEvictedPipelines  = m_stats.numEvictedPipelines.load();
     return result;
   }
 
 
+  void DxvkPipelineManager::notifyPipelineIdle(
+          DxvkGraphicsPipeline*   pipeline) {
+    uint32_t maxCount = m_device->config().maxOptimizedPipelines;
+
+    if (!maxCount)
+      return;
+
+    std::lock_guard lock(m_evictionMutex);
+    m_idlePipelines.insert(pipeline);
+
+    if (m_stats.numOptimizedPipelines.load() <= maxCount)
+      return;
+
+    // Pipelines are ordered by the time they became idle, so
+    // we can stop at the first one that is still too recent.
+    uint32_t frameId = m_device->getCurrentFrameId();
+    uint32_t maxAge = m_device->config().pipelineEvictionFrames;
+
+    auto iter = m_idlePipelines.leastRecentlyUsedIter();
+
+    while (iter != m_idlePipelines.leastRecentlyUsedEndIter()
+        && m_stats.numOptimizedPipelines.load() > maxCount) {
+      if (frameId - (*iter)->getIdleFrameId() < maxAge)
+        break;
+
+      // If the pipeline is in use again, it will get re-added
+      // to the list once its use count drops to zero again.
+      (*iter)->evictOptimizedPipelines();
+
+      iter = m_idlePipelines.remove(iter);
+    }
+  }
+
+
   void DxvkPipelineManager::stopWorkerThreads() {
     m_workers.stopWorkers();
   }
@@ -8,6 +8,8 @@
 #include "dxvk_compute.h"
 #include "dxvk_graphics.h"
 
+#include "../util/util_lru.h"
+
 namespace dxvk {
 
   class DxvkDevice;
@@ -22,6 +24,8 @@ namespace dxvk {
     uint32_t numGraphicsPipelines;
     uint32_t numGraphicsLibraries;
     uint32_t numComputePipelines;
+    uint32_t numOptimizedPipelines;
+    uint32_t numEvictedPipelines;
   };
 
   /**
@@ -31,6 +35,8 @@ namespace dxvk {
     std::atomic<uint32_t> numGraphicsPipelines  = { 0u };
     std::atomic<uint32_t> numGraphicsLibraries  = { 0u };
     std::atomic<uint32_t> numComputePipelines   = { 0u };
+    std::atomic<uint32_t> numOptimizedPipelines = { 0u };
+    std::atomic<uint32_t> numEvictedPipelines   = { 0u };
   };
 
   struct DxvkPipelineWorkerStats {
@@ -284,6 +290,18 @@ namespace dxvk {
       return m_specLayout;
     }
 
+    /**
+     * \brief Notifies the manager that a pipeline is unused
+     *
+     * Called when the use count of a graphics pipeline drops to
+     * zero. If the number of optimized pipelines exceeds the
+     * configured limit, this will evict optimized pipelines that
+     * have not been used in a while, oldest first.
+     * \param [in] pipeline The graphics pipeline
+     */
+    void notifyPipelineIdle(
+            DxvkGraphicsPipeline*   pipeline);
+
     /**
      * \brief Stops async compiler threads
      */
@@ -336,6 +354,9 @@ namespace dxvk {
       DxvkGraphicsPipeline,
       DxvkHash, DxvkEq> m_graphicsPipelines;
 
+    dxvk::mutex                     m_evictionMutex;
+    lru_list<DxvkGraphicsPipeline*> m_idlePipelines;
+
     DxvkShaderPipelineLibrary* createPipelineLibraryLocked(
       const DxvkShaderPipelineLibraryKey& key);
 
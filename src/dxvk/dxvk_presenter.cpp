@@ -52,6 +52,18 @@ namespace dxvk {
 
   
   Presenter::~Presenter() {
+    // Let the acquire thread finish any pending
+    // acquire before tearing down the swapchain
+    if (m_acquireThread.joinable()) {
+      { std::lock_guard lock(m_surfaceMutex);
+
+        m_acquireStopped = true;
+        m_acquireCond.notify_one();
+      }
+
+      m_acquireThread.join();
+    }
+
     destroySwapchain();
     destroySurface();
     destroyLatencySemaphore();
@@ -246,8 +258,13 @@ namespace dxvk {
     }
 
     // On a successful present, try to acquire next image already, in
-    // order to hide potential delays from the application thread.
-    if (status == VK_SUCCESS) {
+    // order to hide potential delays from the application thread. If
+    // enabled, do this on the acquire thread so that we do not block
+    // the submission thread, and keep the present pending until the
+    // image is acquired so that nothing else can access the swapchain.
+    bool acquireAsync = status == VK_SUCCESS && m_acquireThread.joinable();
+
+    if (status == VK_SUCCESS && !acquireAsync) {
       PresenterSync& nextSync = m_semaphores.at(m_frameIndex);
       waitForSwapchainFence(nextSync);
 
@@ -266,8 +283,14 @@ namespace dxvk {
       m_dirtySwapchain = true;
     }
 
-    m_presentPending = false;
-    m_surfaceCond.notify_one();
+    if (acquireAsync) {
+      m_acquireRequested = true;
+      m_acquireCond.notify_one();
+    } else {
+      m_presentPending = false;
+      m_surfaceCond.notify_one();
+    }
+
     return status;
   }
 
@@ -481,6 +504,11 @@ namespace dxvk {
   }
 
 
+  FpsLimiterStats Presenter::getFramePacingStats() {
+    return m_fpsLimiter.getStats();
+  }
+
+
   void Presenter::setSurfaceFormat(VkSurfaceFormatKHR format) {
     std::lock_guard lock(m_surfaceMutex);
 
@@ -860,6 +888,9 @@ namespace dxvk {
     if (m_signal && m_hasPresentWait && !m_frameThread.joinable())
       m_frameThread = dxvk::thread([this] { runFrameThread(); });
 
+    if (m_device->config().asyncAcquire && !m_acquireThread.joinable())
+      m_acquireThread = dxvk::thread([this] { runAcquireThread(); });
+
     return VK_SUCCESS;
   }
 
@@ -1300,6 +1331,8 @@ namespace dxvk {
       // If the present operation has succeeded, actually wait for it to complete.
       // Don't bother with it on MAILBOX / IMMEDIATE modes since doing so would
       // restrict us to the display refresh rate on some platforms (XWayland).
+      dxvk::high_resolution_clock::time_point presentTime = { };
+
       if (frame.result >= 0 && (frame.mode == VK_PRESENT_MODE_FIFO_KHR || frame.mode == VK_PRESENT_MODE_FIFO_RELAXED_KHR)) {
         VkResult vr;
 
@@ -1316,6 +1349,8 @@ namespace dxvk {
 
         if (vr < 0 && vr != VK_ERROR_OUT_OF_DATE_KHR && vr != VK_ERROR_SURFACE_LOST_KHR)
           Logger::err(str::format("Presenter: vkWaitForPresentKHR failed: ", vr));
+        else if (vr >= 0)
+          presentTime = dxvk::high_resolution_clock::now();
       }
 
       // Signal latency tracker right away to get more accurate
@@ -1327,8 +1362,13 @@ namespace dxvk {
 
       // Apply FPS limiter here to align it as closely with scanout as we can,
       // and delay signaling the frame latency event to emulate behaviour of a
-      // low refresh rate display as closely as we can.
-      m_fpsLimiter.delay();
+      // low refresh rate display as closely as we can. If we know when the
+      // frame was actually displayed, use that to lock on to the display's
+      // cadence rather than relying on CPU timings alone.
+      if (presentTime != dxvk::high_resolution_clock::time_point())
+        m_fpsLimiter.delay(presentTime);
+      else
+        m_fpsLimiter.delay();
 
       // Wake up any thread that may be waiting for the queue to become empty
       bool canSignal = false;
@@ -1350,6 +1390,47 @@ namespace dxvk {
   }
 
 
+  void Presenter::runAcquireThread() {
+    env::setThreadName("dxvk-acquire");
+
+    std::unique_lock lock(m_surfaceMutex);
+
+    while (true) {
+      m_acquireCond.wait(lock, [this] {
+        return m_acquireRequested || m_acquireStopped;
+      });
+
+      // Always process pending requests before exiting
+      if (!m_acquireRequested)
+        return;
+
+      m_acquireRequested = false;
+
+      // The present is still pending at this point, which means that no
+      // other thread will touch the swapchain or any of the acquire state
+      // until we're done, so it is safe to acquire without the lock held.
+      lock.unlock();
+
+      PresenterSync& nextSync = m_semaphores.at(m_frameIndex);
+      waitForSwapchainFence(nextSync);
+
+      VkResult vr = m_vkd->vkAcquireNextImageKHR(m_vkd->device(),
+        m_swapchain, std::numeric_limits<uint64_t>::max(),
+        nextSync.acquire, VK_NULL_HANDLE, &m_imageIndex);
+
+      // Any error, including OUT_OF_DATE and SUBOPTIMAL, is handled
+      // by the next call to acquireNextImage as if we had acquired
+      // the image on the submission thread.
+      lock.lock();
+
+      m_acquireStatus = vr;
+
+      m_presentPending = false;
+      m_surfaceCond.notify_one();
+    }
+  }
+
+
   VkResult Presenter::softError(
           VkResult                  vr) {
     // Don't return these as an error state to the caller. The app can't
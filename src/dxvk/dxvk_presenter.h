@@ -161,6 +161,16 @@ namespace dxvk {
      */
     void setFrameRateLimit(double frameRate, uint32_t maxLatency);
 
+    /**
+     * \brief Queries frame pacing statistics
+     *
+     * Only meaningful if the frame rate limiter is active.
+     * Resets the statistics, so there should only be one
+     * consumer at a time.
+     * \returns Frame pacing statistics since last query
+     */
+    FpsLimiterStats getFramePacingStats();
+
     /**
      * \brief Sets preferred color space and format
      *
@@ -301,6 +311,11 @@ namespace dxvk {
     VkResult                    m_acquireStatus = VK_NOT_READY;
     bool                        m_presentPending = false;
 
+    dxvk::condition_variable    m_acquireCond;
+    dxvk::thread                m_acquireThread;
+    bool                        m_acquireRequested = false;
+    bool                        m_acquireStopped = false;
+
     std::optional<VkHdrMetadataEXT> m_hdrMetadata;
     bool                        m_hdrMetadataDirty = false;
 
@@ -387,6 +402,8 @@ namespace dxvk {
 
     void runFrameThread();
 
+    void runAcquireThread();
+
     static VkResult softError(
             VkResult                  vr);
 
@@ -23,6 +23,13 @@ namespace dxvk {
       throw DxvkError(str::format("Failed to create timeline semaphores: ",
         vrGraphics > vrTransfer ? vrGraphics : vrTransfer));
     }
+
+    if (m_device->hasAsyncComputeQueue()) {
+      VkResult vrCompute = vk->vkCreateSemaphore(vk->device(), &semaphoreInfo, nullptr, &m_semaphores.compute);
+
+      if (vrCompute)
+        throw DxvkError(str::format("Failed to create timeline semaphores: ", vrCompute));
+    }
   }
   
   
@@ -41,6 +48,7 @@ namespace dxvk {
 
     vk->vkDestroySemaphore(vk->device(), m_semaphores.graphics, nullptr);
     vk->vkDestroySemaphore(vk->device(), m_semaphores.transfer, nullptr);
+    vk->vkDestroySemaphore(vk->device(), m_semaphores.compute, nullptr);
   }
   
   
@@ -59,7 +67,7 @@ namespace dxvk {
     entry.submit = std::move(submitInfo);
     entry.latency = std::move(latencyInfo);
 
-    m_submitQueue.push(std::move(entry));
+    m_submitQueue.push_back(std::move(entry));
     m_appendCond.notify_all();
   }
 
@@ -75,7 +83,7 @@ namespace dxvk {
     entry.present = std::move(presentInfo);
     entry.latency = std::move(latencyInfo);
 
-    m_submitQueue.push(std::move(entry));
+    m_submitQueue.push_back(std::move(entry));
     m_appendCond.notify_all();
   }
 
@@ -134,9 +142,9 @@ namespace dxvk {
     uint64_t trackedSubmitId = 0u;
     uint64_t trackedPresentId = 0u;
 
-    while (!m_stopped.load()) {
-      DxvkSubmitEntry entry;
+    std::vector<DxvkSubmitEntry> entries;
 
+    while (!m_stopped.load()) {
       { std::unique_lock<dxvk::mutex> lock(m_mutex);
 
         m_appendCond.wait(lock, [this] {
@@ -146,77 +154,113 @@ namespace dxvk {
         if (m_stopped.load())
           return;
 
-        entry = std::move(m_submitQueue.front());
+        // Take all command lists that are already queued up to the next
+        // present, so that they can be submitted with a single call. Never
+        // wait for more work here since that would only add latency.
+        for (auto& entry : m_submitQueue) {
+          bool isPresent = entry.present.presenter != nullptr;
+
+          if (isPresent && !entries.empty())
+            break;
+
+          entries.push_back(std::move(entry));
+
+          if (isPresent)
+            break;
+        }
       }
 
-      // Submit command buffer to device
+      // Submit command buffers to device
       if (m_lastError != VK_ERROR_DEVICE_LOST) {
         std::lock_guard<dxvk::mutex> lock(m_mutexQueue);
 
         if (m_callback)
           m_callback(true);
 
-        if (entry.submit.cmdList != nullptr) {
-          if (entry.latency.tracker) {
-            entry.latency.tracker->notifyQueueSubmit(entry.latency.frameId);
+        for (auto& entry : entries) {
+          if (entry.submit.cmdList != nullptr) {
+            if (entry.latency.tracker) {
+              entry.latency.tracker->notifyQueueSubmit(entry.latency.frameId);
 
-            if (!trackedSubmitId && entry.latency.frameId > trackedPresentId)
-              trackedSubmitId = entry.latency.frameId;
-          }
+              if (!trackedSubmitId && entry.latency.frameId > trackedPresentId)
+                trackedSubmitId = entry.latency.frameId;
+            }
 
-          entry.result = entry.submit.cmdList->submit(
-            m_semaphores, m_timelines, trackedSubmitId);
-          entry.timelines = m_timelines;
-        } else if (entry.present.presenter != nullptr) {
-          if (entry.latency.tracker)
-            entry.latency.tracker->notifyQueuePresentBegin(entry.latency.frameId);
+            entry.result = entry.submit.cmdList->submit(
+              m_semaphores, m_timelines, trackedSubmitId, m_batch);
+            entry.timelines = m_timelines;
+          } else if (entry.present.presenter != nullptr) {
+            if (entry.latency.tracker)
+              entry.latency.tracker->notifyQueuePresentBegin(entry.latency.frameId);
 
-          entry.result = entry.present.presenter->presentImage(
-            entry.present.frameId, entry.latency.tracker);
+            entry.result = entry.present.presenter->presentImage(
+              entry.present.frameId, entry.latency.tracker);
 
-          if (entry.latency.tracker) {
-            entry.latency.tracker->notifyQueuePresentEnd(
-              entry.latency.frameId, entry.result);
+            if (entry.latency.tracker) {
+              entry.latency.tracker->notifyQueuePresentEnd(
+                entry.latency.frameId, entry.result);
 
-            trackedPresentId = entry.latency.frameId;
-            trackedSubmitId = 0u;
+              trackedPresentId = entry.latency.frameId;
+              trackedSubmitId = 0u;
+            }
           }
         }
 
+        // Submit any batches that the command lists left pending. If this
+        // fails, we cannot know which command list caused the error.
+        VkResult batchResult = m_batch.flush(m_device);
+        auto submitTime = dxvk::high_resolution_clock::now();
+
+        for (auto& entry : entries) {
+          if (entry.submit.cmdList != nullptr) {
+            if (entry.result == VK_SUCCESS)
+              entry.result = batchResult;
+
+            entry.submitTime = submitTime;
+          }
+        }
+
+        m_queueSubmitCount.store(m_batch.getSubmitCount());
+
         if (m_callback)
           m_callback(false);
       } else {
         // Don't submit anything after device loss
         // so that drivers get a chance to recover
-        entry.result = VK_ERROR_DEVICE_LOST;
+        for (auto& entry : entries)
+          entry.result = VK_ERROR_DEVICE_LOST;
       }
 
-      if (entry.status)
-        entry.status->result = entry.result;
+      for (auto& entry : entries) {
+        if (entry.status)
+          entry.status->result = entry.result;
 
-      if (entry.result == VK_ERROR_DEVICE_LOST && m_checkpoints)
-        m_checkpoints->printHangInfo();
+        if (entry.result == VK_ERROR_DEVICE_LOST && m_checkpoints)
+          m_checkpoints->printHangInfo();
 
-      // On success, pass it on to the queue thread
-      { std::unique_lock<dxvk::mutex> lock(m_mutex);
+        // On success, pass it on to the queue thread
+        { std::unique_lock<dxvk::mutex> lock(m_mutex);
 
-        bool doForward = (entry.result == VK_SUCCESS) ||
-          (entry.present.presenter != nullptr && entry.result != VK_ERROR_DEVICE_LOST);
+          bool doForward = (entry.result == VK_SUCCESS) ||
+            (entry.present.presenter != nullptr && entry.result != VK_ERROR_DEVICE_LOST);
 
-        if (doForward) {
-          m_finishQueue.push(std::move(entry));
-        } else {
-          Logger::err(str::format("DxvkSubmissionQueue: Command submission failed: ", entry.result));
-          m_lastError = entry.result;
+          if (doForward) {
+            m_finishQueue.push(std::move(entry));
+          } else {
+            Logger::err(str::format("DxvkSubmissionQueue: Command submission failed: ", entry.result));
+            m_lastError = entry.result;
 
-          if (m_lastError != VK_ERROR_DEVICE_LOST)
-            m_device->waitForIdle();
-        }
+            if (m_lastError != VK_ERROR_DEVICE_LOST)
+              m_device->waitForIdle();
+          }
 
-        m_submitQueue.pop();
-        m_submitCond.notify_all();
+          m_submitQueue.pop_front();
+          m_submitCond.notify_all();
+        }
       }
 
+      entries.clear();
+
       // Good time to invoke allocator tasks now since we
       // expect this to get called somewhat periodically.
       m_device->m_objects.memoryManager().performTimedTasks();
@@ -229,6 +273,8 @@ namespace dxvk {
 
     auto vk = m_device->vkd();
 
+    high_resolution_clock::time_point lastCompletion = { };
+
     while (!m_stopped.load()) {
       std::unique_lock<dxvk::mutex> lock(m_mutex);
 
@@ -268,6 +314,18 @@ namespace dxvk {
 
           if (entry.latency.tracker && status == VK_SUCCESS)
             entry.latency.tracker->notifyGpuExecutionEnd(entry.latency.frameId);
+
+          if (status == VK_SUCCESS) {
+            // The GPU can only start executing this submission once
+            // it is submitted and the previous one has completed.
+            auto t = dxvk::high_resolution_clock::now();
+            auto start = std::max(entry.submitTime, lastCompletion);
+
+            m_gpuSubmissionTicks += std::chrono::duration_cast<std::chrono::microseconds>(t - start).count();
+            m_gpuSubmissionCount += 1u;
+
+            lastCompletion = t;
+          }
         }
 
         if (status == VK_ERROR_DEVICE_LOST && m_checkpoints)
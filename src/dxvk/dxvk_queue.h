@@ -1,6 +1,7 @@
 #pragma once
 
 #include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <queue>
 
@@ -71,6 +72,26 @@ namespace dxvk {
     DxvkPresentInfo     present;
     DxvkLatencyInfo     latency;
     DxvkTimelineSemaphoreValues timelines;
+    high_resolution_clock::time_point submitTime;
+  };
+
+
+  /**
+   * \brief Submission statistics
+   *
+   * Monotonically increasing counters that can be
+   * sampled periodically to derive GPU load and the
+   * average GPU execution time per submission.
+   */
+  struct DxvkSubmissionStats {
+    /// Accumulated GPU idle time, in us
+    uint64_t gpuIdleTicks = 0u;
+    /// Number of completed command submissions
+    uint64_t submissionCount = 0u;
+    /// Accumulated GPU time of completed submissions, in us
+    uint64_t submissionTicks = 0u;
+    /// Number of queue submit calls made to the driver
+    uint64_t queueSubmitCount = 0u;
   };
 
 
@@ -99,6 +120,23 @@ namespace dxvk {
       return m_gpuIdle.load();
     }
 
+    /**
+     * \brief Retrieves submission statistics
+     *
+     * The GPU time of a submission is estimated as the time
+     * between the submission, or completion of the previous
+     * submission if that happened later, and its completion.
+     * \returns Current submission statistics
+     */
+    DxvkSubmissionStats getStatistics() const {
+      DxvkSubmissionStats result;
+      result.gpuIdleTicks = m_gpuIdle.load();
+      result.submissionCount = m_gpuSubmissionCount.load();
+      result.submissionTicks = m_gpuSubmissionTicks.load();
+      result.queueSubmitCount = m_queueSubmitCount.load();
+      return result;
+    }
+
     /**
      * \brief Retrieves last submission error
      * 
@@ -206,6 +244,9 @@ namespace dxvk {
     
     std::atomic<bool>           m_stopped = { false };
     std::atomic<uint64_t>       m_gpuIdle = { 0ull };
+    std::atomic<uint64_t>       m_gpuSubmissionCount = { 0ull };
+    std::atomic<uint64_t>       m_gpuSubmissionTicks = { 0ull };
+    std::atomic<uint64_t>       m_queueSubmitCount = { 0ull };
 
     dxvk::mutex                 m_mutex;
     dxvk::mutex                 m_mutexQueue;
@@ -214,9 +255,11 @@ namespace dxvk {
     dxvk::condition_variable    m_submitCond;
     dxvk::condition_variable    m_finishCond;
 
-    std::queue<DxvkSubmitEntry> m_submitQueue;
+    std::deque<DxvkSubmitEntry> m_submitQueue;
     std::queue<DxvkSubmitEntry> m_finishQueue;
 
+    DxvkSubmissionBatch         m_batch;
+
     dxvk::thread                m_submitThread;
     dxvk::thread                m_finishThread;
 
@@ -540,7 +540,12 @@ namespace dxvk {
       // a ref count of 0, it is possible that we reach this before
       // the releasing thread inserted the list into the LRU list.
       if (!sampler.object->m_refCount.fetch_add(1u)) {
-        removeLru(sampler, entry->second);
+        if (samplerIsInLruList(sampler, entry->second)) {
+          removeLru(sampler, entry->second);
+
+          m_samplersCached.store(m_samplersCached.load() - 1u);
+          m_samplersReused.store(m_samplersReused.load() + 1u);
+        }
 
         m_samplersLive.store(m_samplersLive.load() + 1u);
       }
@@ -565,6 +570,9 @@ namespace dxvk {
     if (sampler.object) {
       m_samplerLut.erase(sampler.object->key());
       sampler.object.reset();
+
+      m_samplersCached.store(m_samplersCached.load() - 1u);
+      m_samplersEvicted.store(m_samplersEvicted.load() + 1u);
     }
 
     removeLru(sampler, samplerIndex);
@@ -575,6 +583,7 @@ namespace dxvk {
 
     // Update statistics
     m_samplersLive.store(m_samplersLive.load() + 1u);
+    m_samplersCreated.store(m_samplersCreated.load() + 1u);
     return &sampler.object.value();
   }
 
@@ -604,6 +613,8 @@ namespace dxvk {
     // object itself as well as the look-up table entry intact in
     // case the app wants to recreate the same sampler later.
     appendLru(sampler, index);
+
+    m_samplersCached.store(m_samplersCached.load() + 1u);
   }
 
 
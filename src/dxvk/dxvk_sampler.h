@@ -359,6 +359,14 @@ namespace dxvk {
   struct DxvkSamplerStats {
     /// Number of samplers currently in use
     uint32_t liveCount = 0u;
+    /// Number of unused samplers kept alive for reuse
+    uint32_t cachedCount = 0u;
+    /// Total number of Vulkan samplers created
+    uint64_t createCount = 0u;
+    /// Total number of unused samplers that were reused
+    uint64_t reuseCount = 0u;
+    /// Total number of unused samplers that were evicted
+    uint64_t evictCount = 0u;
   };
 
 
@@ -413,6 +421,10 @@ namespace dxvk {
     DxvkSamplerStats getStats() const {
       DxvkSamplerStats stats = { };
       stats.liveCount = m_samplersLive.load();
+      stats.cachedCount = m_samplersCached.load();
+      stats.createCount = m_samplersCreated.load();
+      stats.reuseCount = m_samplersReused.load();
+      stats.evictCount = m_samplersEvicted.load();
       return stats;
     }
 
@@ -437,7 +449,11 @@ namespace dxvk {
     int32_t m_lruHead = -1;
     int32_t m_lruTail = -1;
 
-    std::atomic<uint32_t> m_samplersLive = { 0u };
+    std::atomic<uint32_t> m_samplersLive    = { 0u };
+    std::atomic<uint32_t> m_samplersCached  = { 0u };
+    std::atomic<uint64_t> m_samplersCreated = { 0u };
+    std::atomic<uint64_t> m_samplersReused  = { 0u };
+    std::atomic<uint64_t> m_samplersEvicted = { 0u };
 
     Rc<DxvkSampler> m_default = nullptr;
 
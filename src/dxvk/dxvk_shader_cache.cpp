@@ -37,8 +37,19 @@ namespace dxvk {
     k.name = name;
     k.createInfo = options;
 
+    std::unique_lock lock(m_fileMutex);
+
     auto entry = m_lut.find(k);
 
+    if (entry == m_lut.end()) {
+      // Another process may have written the shader in the meantime
+      lock.unlock();
+      rescanLut(false);
+      lock.lock();
+
+      entry = m_lut.find(k);
+    }
+
     if (entry == m_lut.end()) {
       if (Logger::logLevel() <= LogLevel::Debug)
         Logger::debug(str::format("Shader cache miss: ", name));
@@ -53,16 +64,28 @@ namespace dxvk {
         ", metadata: ", entry->second.metadataSize, ")"));
     }
 
-    std::unique_lock lock(m_fileMutex);
     auto shader = loadCachedShaderLocked(entry->first, entry->second);
 
     if (!shader) {
       Logger::warn(str::format("Failed to load cached shader ", name));
 
-      if (!openWriteOnlyLocked())
-        Logger::warn(str::format("Failed to re-initialize shader cache ", name));
+      // Re-opening the files must not race with the writer
+      // thread, which accesses the look-up table file lock
+      lock.unlock();
 
-      m_status.store(Status::OpenWriteOnly);
+      std::unique_lock lutLock(m_lutMutex);
+      lock.lock();
+
+      // Another thread may have already discarded the cache. If other
+      // processes are still using it, it cannot be re-created safely.
+      if (m_status.load() == Status::OpenReadWrite) {
+        if (openWriteOnlyLocked()) {
+          m_status.store(Status::OpenWriteOnly);
+        } else {
+          Logger::warn(str::format("Failed to re-initialize shader cache ", name));
+          m_status.store(Status::CacheDisabled);
+        }
+      }
     }
 
     return shader;
@@ -77,7 +100,11 @@ namespace dxvk {
     k.name = shader->debugName();
     k.createInfo = shader->getShaderCreateInfo();
 
-    if (m_lut.find(k) == m_lut.end()) {
+    std::unique_lock fileLock(m_fileMutex);
+    bool found = m_lut.find(k) != m_lut.end();
+    fileLock.unlock();
+
+    if (!found) {
       std::unique_lock lock(m_writeMutex);
       m_writeQueue.push(std::move(shader));
       m_writeCond.notify_one();
@@ -99,6 +126,7 @@ namespace dxvk {
 
 
   DxvkShaderCache::Status DxvkShaderCache::initialize() {
+    std::unique_lock lutLock(m_lutMutex);
     std::unique_lock lock(m_fileMutex);
     auto status = m_status.load();
 
@@ -131,14 +159,13 @@ namespace dxvk {
 
 
   bool DxvkShaderCache::openReadWriteLocked() {
-    // Try to open both files in read-only mode for now, re-open
-    // in read-write mode when we actually add new cache entries.
+    // Open files in shared mode so that multiple processes can use
+    // the same cache, accesses are synchronized via file locks.
     auto path = m_filePaths.directory + env::PlatformDirSlash;
 
     auto flags = util::FileFlags(
       util::FileFlag::AllowRead,
-      util::FileFlag::AllowWrite,
-      util::FileFlag::Exclusive);
+      util::FileFlag::AllowWrite);
 
     m_binFile.open(path + m_filePaths.binFile, flags);
     m_lutFile.open(path + m_filePaths.lutFile, flags);
@@ -146,6 +173,26 @@ namespace dxvk {
     if (!m_binFile || !m_lutFile)
       return false;
 
+    // If the file system does not support locking, fall back to
+    // opening the cache exclusively so that only one process can
+    // write to it at a time. This fails if other processes are
+    // using the cache, or if exclusive access cannot be guaranteed.
+    m_shared = m_lutFile.lock(false);
+
+    if (m_shared) {
+      m_lutFile.unlock();
+    } else {
+      Logger::warn("Failed to lock cache file, disabling shared access.");
+
+      flags.set(util::FileFlag::Exclusive);
+
+      m_binFile.open(path + m_filePaths.binFile, flags);
+      m_lutFile.open(path + m_filePaths.lutFile, flags);
+
+      if (!m_binFile || !m_lutFile)
+        return false;
+    }
+
     Logger::info(str::format("Found cache file: ", path + m_filePaths.binFile));
     return true;
   }
@@ -153,6 +200,9 @@ namespace dxvk {
 
   bool DxvkShaderCache::openWriteOnlyLocked() {
     // Didn't have a lot of success so far, nuke the files and retry.
+    // Opening the files exclusively fails if they are in use by any
+    // other process, so that we never truncate a cache that another
+    // process is still reading from or appending to.
     auto path = m_filePaths.directory + env::PlatformDirSlash;
 
     auto flags = util::FileFlags(
@@ -193,6 +243,12 @@ namespace dxvk {
       return false;
     }
 
+    m_lut.clear();
+    m_lutOffset = m_lutFile.size();
+
+    // Files are opened exclusively here, so other processes
+    // cannot open the cache until this process closes it.
+    m_shared = false;
     return true;
   }
 
@@ -200,33 +256,42 @@ namespace dxvk {
   bool DxvkShaderCache::parseLut() {
     LutHeader header;
 
-    size_t size = m_lutFile.size();
     size_t offset = 0u;
 
+    bool locked = m_shared && m_lutFile.lock(false);
+
     if (!readBytes(m_lutFile, header.magic.data(), offset, header.magic.size())
      || !readString(m_lutFile, offset, header.versionString)) {
       Logger::warn("Failed to parse cache file header.");
+
+      if (locked)
+        m_lutFile.unlock();
       return false;
     }
 
     if (header.versionString != DXVK_VERSION) {
       Logger::warn(str::format("Cache was created with DXVK version ", header.versionString,
         ", but current version is ", DXVK_VERSION, ". Discarding old cache."));
+
+      if (locked)
+        m_lutFile.unlock();
       return false;
     }
 
-    while (offset < size) {
-      LutKey k;
-      LutEntry e;
+    m_lutOffset = offset;
 
-      if (!readShaderLutEntry(k, e, offset)) {
-        Logger::warn("Failed to parse cache look-up table.");
-        return false;
-      }
+    bool status = parseLutEntriesLocked();
 
-      m_lut.insert_or_assign(k, e);
+    if (locked)
+      m_lutFile.unlock();
+
+    if (!status) {
+      Logger::warn("Failed to parse cache look-up table.");
+      return false;
     }
 
+    m_lutScanTime = high_resolution_clock::now();
+
     auto cacheSize = m_binFile.size();;
 
     std::stringstream message;
@@ -246,6 +311,65 @@ namespace dxvk {
   }
 
 
+  bool DxvkShaderCache::parseLutEntriesLocked() {
+    size_t size = m_lutFile.size();
+
+    while (m_lutOffset < size) {
+      LutKey k;
+      LutEntry e;
+
+      size_t offset = m_lutOffset;
+
+      if (!readShaderLutEntry(k, e, offset))
+        return false;
+
+      m_lut.insert_or_assign(k, e);
+      m_lutOffset = offset;
+    }
+
+    return true;
+  }
+
+
+  void DxvkShaderCache::rescanLut(bool force) {
+    constexpr auto ScanInterval = std::chrono::milliseconds(1000);
+
+    // Don't wait for the writer thread on cache misses, it will
+    // pick up any new entries after its current batch anyway.
+    std::unique_lock lutLock(m_lutMutex, std::defer_lock);
+
+    if (force)
+      lutLock.lock();
+    else if (!lutLock.try_lock())
+      return;
+
+    if (!m_shared)
+      return;
+
+    auto now = high_resolution_clock::now();
+
+    if (!force && now - m_lutScanTime < ScanInterval)
+      return;
+
+    m_lutScanTime = now;
+
+    // Entries are only ever appended while holding an exclusive lock,
+    // so a failure here means that the file is actually broken. Keep
+    // the current offset so that we do not pick up garbage entries.
+    if (!m_lutFile.lock(false))
+      return;
+
+    std::unique_lock fileLock(m_fileMutex);
+
+    if (!parseLutEntriesLocked())
+      Logger::warn("Failed to parse new cache look-up table entries.");
+
+    fileLock.unlock();
+
+    m_lutFile.unlock();
+  }
+
+
   bool DxvkShaderCache::writeShaderXfbInfo(util::File& stream, const dxbc_spv::ir::IoXfbInfo& xfb) {
     return writeString(stream, xfb.semanticName)
         && write(stream, xfb.semanticIndex)
@@ -499,12 +623,30 @@ namespace dxvk {
       }
 
       if (drain) {
+        std::unique_lock lutLock(m_lutMutex);
+
+        // Hold an exclusive lock on the look-up table while appending so
+        // that binary offsets stay valid even if another process is also
+        // writing to the same cache, and so that readers never observe
+        // partially written entries. This may block for a while, so do
+        // not hold the file mutex here to not stall shader look-ups.
+        bool shared = m_shared;
+
+        if (shared && !m_lutFile.lock(true)) {
+          Logger::err("Failed to lock cache file.");
+          m_status = Status::CacheDisabled;
+          return;
+        }
+
         std::unique_lock fileLock(m_fileMutex);
 
         for (const auto& shader : localQueue) {
           if (!writeShaderToCache(*shader)) {
             Logger::err("Failed to write cache file.");
             m_status = Status::CacheDisabled;
+
+            if (shared)
+              m_lutFile.unlock();
             return;
           }
         }
@@ -513,6 +655,18 @@ namespace dxvk {
 
         m_binFile.flush();
         m_lutFile.flush();
+
+        fileLock.unlock();
+
+        if (shared)
+          m_lutFile.unlock();
+
+        lutLock.unlock();
+
+        // Pick up our own entries as well as anything that other processes
+        // added since the last scan, so we don't write duplicates.
+        if (m_status.load() == Status::OpenReadWrite)
+          rescanLut(true);
       }
     }
   }
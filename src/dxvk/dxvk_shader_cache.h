@@ -11,6 +11,7 @@
 #include "../util/thread.h"
 #include "../util/util_env.h"
 #include "../util/util_file.h"
+#include "../util/util_time.h"
 
 #include "dxvk_shader_ir.h"
 
@@ -24,6 +25,11 @@ namespace dxvk {
    * The implementation creates two files that can trivially grow by appending
    * data to them: A binary blob that contains the actual serialized IR as well
    * as shader metadata, and a look-up table
+   *
+   * Multiple processes can share the same cache files. Appends are serialized
+   * via an advisory lock on the look-up table, and look-up table entries added
+   * by other processes are picked up periodically on cache misses. If the
+   * file system does not support locking, the cache is opened exclusively.
    */
   class DxvkShaderCache {
 
@@ -118,6 +124,8 @@ namespace dxvk {
     std::atomic<uint32_t>         m_useCount = { 0u };
 
     FilePaths                     m_filePaths;
+
+    dxvk::mutex                   m_lutMutex;
     dxvk::mutex                   m_fileMutex;
 
     util::File                    m_lutFile;
@@ -127,6 +135,10 @@ namespace dxvk {
 
     std::unordered_map<LutKey, LutEntry, DxvkHash, DxvkEq> m_lut;
 
+    size_t                        m_lutOffset = 0u;
+    bool                          m_shared = false;
+    high_resolution_clock::time_point m_lutScanTime = { };
+
     dxvk::mutex                   m_writeMutex;
     dxvk::condition_variable      m_writeCond;
     std::queue<Rc<DxvkIrShader>>  m_writeQueue;
@@ -147,6 +159,10 @@ namespace dxvk {
 
     bool parseLut();
 
+    bool parseLutEntriesLocked();
+
+    void rescanLut(bool force);
+
     Rc<DxvkIrShader> loadCachedShaderLocked(const LutKey& key, const LutEntry& entry);
 
     bool writeShaderLutEntry(DxvkIrShader& shader, const LutEntry& entry);
@@ -13,12 +13,17 @@ namespace dxvk {
   enum class DxvkStatCounter : uint32_t {
     CmdDrawCalls,             ///< Number of draw calls
     CmdDrawsMerged,           ///< Number of unique draws, minus draw calls
+    CmdDrawsUnoptimized,      ///< Number of draws using base pipelines
     CmdDispatchCalls,         ///< Number of compute calls
+    CmdDispatchAsyncCalls,    ///< Number of compute calls on the async queue
     CmdRenderPassCount,       ///< Number of render passes
+    CmdRenderPassesMerged,    ///< Number of render pass splits avoided by buffer relocation
     CmdBarrierCount,          ///< Number of pipeline barriers
     PipeCountGraphics,        ///< Number of graphics pipelines
     PipeCountLibrary,         ///< Number of graphics shader libraries
     PipeCountCompute,         ///< Number of compute pipelines
+    PipeCountOptimized,       ///< Number of live optimized graphics pipelines
+    PipeCountEvicted,         ///< Number of evicted optimized graphics pipelines
     PipeTasksDone,            ///< Boolean indicating compiler activity
     PipeTasksTotal,           ///< Boolean indicating compiler activity
     QueueSubmitCount,         ///< Number of command buffer submissions
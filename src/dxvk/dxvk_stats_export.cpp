@@ -0,0 +1,291 @@
+#include "dxvk_device.h"
+#include "dxvk_stats_export.h"
+
+#include "../util/util_env.h"
+
+namespace dxvk {
+
+  static constexpr std::array<const char*, uint32_t(DxvkStatCounter::NumCounters)> g_counterNames = {{
+    "CmdDrawCalls",
+    "CmdDrawsMerged",
+    "CmdDrawsUnoptimized",
+    "CmdDispatchCalls",
+    "CmdDispatchAsyncCalls",
+    "CmdRenderPassCount",
+    "CmdRenderPassesMerged",
+    "CmdBarrierCount",
+    "PipeCountGraphics",
+    "PipeCountLibrary",
+    "PipeCountCompute",
+    "PipeCountOptimized",
+    "PipeCountEvicted",
+    "PipeTasksDone",
+    "PipeTasksTotal",
+    "QueueSubmitCount",
+    "QueuePresentCount",
+    "GpuSyncCount",
+    "GpuSyncTicks",
+    "GpuIdleTicks",
+    "CsSyncCount",
+    "CsSyncTicks",
+    "CsIdleTicks",
+    "CsChunkCount",
+    "DescriptorPoolCount",
+    "DescriptorSetCount",
+    "DescriptorHeapCount",
+    "DescriptorHeapSize",
+    "DescriptorHeapUsed",
+    "DescriptorCopyBusyTicks",
+  }};
+
+
+  static constexpr bool validateCounterNames() {
+    for (auto name : g_counterNames) {
+      if (!name)
+        return false;
+    }
+
+    return true;
+  }
+
+  static_assert(validateCounterNames(), "Stat counter name missing");
+
+
+  DxvkStatsExporter::DxvkStatsExporter(
+          DxvkDevice*               device,
+    const std::string&              path)
+  : m_device(device) {
+    m_format = (path.size() >= 5u && path.compare(path.size() - 5u, 5u, ".json") == 0)
+            || (path.size() >= 6u && path.compare(path.size() - 6u, 6u, ".jsonl") == 0)
+      ? DxvkStatsExportFormat::JsonLines
+      : DxvkStatsExportFormat::Csv;
+
+    m_file = std::ofstream(str::topath(path.c_str()).c_str());
+
+    if (!m_file) {
+      Logger::err(str::format("Stats export: Failed to open ", path));
+      return;
+    }
+
+    Logger::info(str::format("Stats export: Writing frame statistics to ", path));
+
+    auto memory = m_device->adapter()->memoryProperties();
+    m_heapCount = memory.memoryHeapCount;
+
+    writeHeader();
+
+    m_thread = dxvk::thread([this] { runWorker(); });
+  }
+
+
+  DxvkStatsExporter::~DxvkStatsExporter() {
+    if (!m_thread.joinable())
+      return;
+
+    { std::unique_lock lock(m_mutex);
+      m_stopped = true;
+    }
+
+    m_cond.notify_one();
+    m_thread.join();
+
+    if (m_markersDropped) {
+      Logger::warn(str::format("Stats export: Dropped ", m_markersDropped,
+        " frames because the export thread could not keep up"));
+    }
+  }
+
+
+  void DxvkStatsExporter::notifyPresent(
+    const Rc<DxvkLatencyTracker>&   tracker,
+          uint64_t                  frameId) {
+    if (!m_thread.joinable())
+      return;
+
+    { std::unique_lock lock(m_mutex);
+
+      if (m_markerWrite - m_markerRead == MaxPendingFrames) {
+        m_markersDropped += 1u;
+        return;
+      }
+    }
+
+    // Only this thread writes markers, and the worker does
+    // not access the current one until it gets published.
+    auto& marker = m_markers[m_markerWrite % MaxPendingFrames];
+    marker.frameId = frameId;
+    marker.time = high_resolution_clock::now();
+    marker.tracker = tracker;
+
+    sampleFrame(marker);
+
+    { std::unique_lock lock(m_mutex);
+      m_markerWrite += 1u;
+    }
+
+    m_cond.notify_one();
+  }
+
+
+  std::unique_ptr<DxvkStatsExporter> DxvkStatsExporter::createFromEnv(
+          DxvkDevice*               device) {
+    std::string path = env::getEnvVar("DXVK_STATS_EXPORT");
+
+    if (path.empty())
+      return nullptr;
+
+    return std::make_unique<DxvkStatsExporter>(device, path);
+  }
+
+
+  void DxvkStatsExporter::runWorker() {
+    env::setThreadName("dxvk-stats");
+
+    while (true) {
+      FrameMarker* marker = nullptr;
+
+      { std::unique_lock lock(m_mutex);
+
+        if (m_markerRead == m_markerWrite) {
+          // Only flush when we run out of work in
+          // order to keep the number of writes low
+          lock.unlock();
+          m_file.flush();
+          lock.lock();
+        }
+
+        m_cond.wait(lock, [this] {
+          return m_stopped || m_markerRead != m_markerWrite;
+        });
+
+        if (m_markerRead == m_markerWrite)
+          break;
+
+        marker = &m_markers[m_markerRead % MaxPendingFrames];
+      }
+
+      DxvkLatencyStats latency = marker->tracker
+        ? marker->tracker->getStatistics(marker->frameId)
+        : DxvkLatencyStats();
+
+      if (m_format == DxvkStatsExportFormat::JsonLines)
+        writeJson(*marker, latency);
+      else
+        writeCsv(*marker, latency);
+
+      marker->tracker = nullptr;
+
+      { std::unique_lock lock(m_mutex);
+        m_markerRead += 1u;
+      }
+    }
+
+    m_file.flush();
+  }
+
+
+  void DxvkStatsExporter::sampleFrame(
+          FrameMarker&              marker) {
+    marker.counters = m_device->getStatCounters();
+
+    for (uint32_t i = 0u; i < m_heapCount; i++)
+      marker.memory[i] = m_device->getMemoryStats(i);
+
+    marker.samplers = m_device->getSamplerStats();
+  }
+
+
+  void DxvkStatsExporter::writeHeader() {
+    if (m_format != DxvkStatsExportFormat::Csv)
+      return;
+
+    m_file << "frame,time_us";
+
+    for (auto name : g_counterNames)
+      m_file << "," << name;
+
+    for (uint32_t i = 0u; i < m_heapCount; i++) {
+      m_file << ",heap" << i << "_allocated"
+             << ",heap" << i << "_used"
+             << ",heap" << i << "_budget";
+    }
+
+    m_file << ",sampler_live,sampler_cached,sampler_created,sampler_reused,sampler_evicted"
+           << ",latency_us,sleep_us,cpu_us,cs_us,gpu_us,present_us"
+           << "\n";
+  }
+
+
+  void DxvkStatsExporter::writeCsv(
+    const FrameMarker&              marker,
+    const DxvkLatencyStats&         latency) {
+    auto timeUs = std::chrono::duration_cast<std::chrono::microseconds>(marker.time - m_startTime);
+
+    m_file << marker.frameId << "," << timeUs.count();
+
+    for (uint32_t i = 0u; i < g_counterNames.size(); i++)
+      m_file << "," << marker.counters.getCtr(DxvkStatCounter(i));
+
+    for (uint32_t i = 0u; i < m_heapCount; i++) {
+      const auto& heap = marker.memory[i];
+
+      m_file << "," << heap.memoryAllocated
+             << "," << heap.memoryUsed
+             << "," << heap.memoryBudget;
+    }
+
+    m_file << "," << marker.samplers.liveCount
+           << "," << marker.samplers.cachedCount
+           << "," << marker.samplers.createCount
+           << "," << marker.samplers.reuseCount
+           << "," << marker.samplers.evictCount
+           << "," << latency.frameLatency.count()
+           << "," << latency.sleepDuration.count()
+           << "," << latency.cpuTime.count()
+           << "," << latency.csTime.count()
+           << "," << latency.gpuTime.count()
+           << "," << latency.presentDelay.count()
+           << "\n";
+  }
+
+
+  void DxvkStatsExporter::writeJson(
+    const FrameMarker&              marker,
+    const DxvkLatencyStats&         latency) {
+    auto timeUs = std::chrono::duration_cast<std::chrono::microseconds>(marker.time - m_startTime);
+
+    m_file << "{\"frame\":" << marker.frameId
+           << ",\"time_us\":" << timeUs.count()
+           << ",\"counters\":{";
+
+    for (uint32_t i = 0u; i < g_counterNames.size(); i++) {
+      m_file << (i ? "," : "") << "\"" << g_counterNames[i] << "\":"
+             << marker.counters.getCtr(DxvkStatCounter(i));
+    }
+
+    m_file << "},\"memory\":[";
+
+    for (uint32_t i = 0u; i < m_heapCount; i++) {
+      const auto& heap = marker.memory[i];
+
+      m_file << (i ? "," : "")
+             << "{\"allocated\":" << heap.memoryAllocated
+             << ",\"used\":" << heap.memoryUsed
+             << ",\"budget\":" << heap.memoryBudget << "}";
+    }
+
+    m_file << "],\"samplers\":{\"live\":" << marker.samplers.liveCount
+           << ",\"cached\":" << marker.samplers.cachedCount
+           << ",\"created\":" << marker.samplers.createCount
+           << ",\"reused\":" << marker.samplers.reuseCount
+           << ",\"evicted\":" << marker.samplers.evictCount
+           << "},\"latency\":{\"latency_us\":" << latency.frameLatency.count()
+           << ",\"sleep_us\":" << latency.sleepDuration.count()
+           << ",\"cpu_us\":" << latency.cpuTime.count()
+           << ",\"cs_us\":" << latency.csTime.count()
+           << ",\"gpu_us\":" << latency.gpuTime.count()
+           << ",\"present_us\":" << latency.presentDelay.count()
+           << "}}\n";
+  }
+
+}
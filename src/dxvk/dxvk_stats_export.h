@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../util/thread.h"
+#include "../util/util_time.h"
+
+#include "dxvk_latency.h"
+#include "dxvk_memory.h"
+#include "dxvk_sampler.h"
+#include "dxvk_stats.h"
+
+namespace dxvk {
+
+  class DxvkDevice;
+
+  /**
+   * \brief Stats export format
+   */
+  enum class DxvkStatsExportFormat : uint32_t {
+    Csv       = 0,
+    JsonLines = 1,
+  };
+
+
+  /**
+   * \brief Per-frame statistics exporter
+   *
+   * Writes stat counters, memory statistics, sampler statistics
+   * and latency statistics to a file once per presented frame.
+   * Presenting a frame takes a snapshot of all counters in a
+   * fixed-size ring buffer, which is formatted and written to
+   * the file by a dedicated worker thread. Latency statistics
+   * are queried by the worker since they are only complete
+   * some time after the frame has been presented.
+   *
+   * Enabled by setting \c DXVK_STATS_EXPORT to a file path. Files
+   * ending in \c .json or \c .jsonl will use JSON lines, all
+   * other files will use CSV. Counter values are cumulative.
+   */
+  class DxvkStatsExporter {
+    constexpr static uint32_t MaxPendingFrames = 256u;
+  public:
+
+    DxvkStatsExporter(
+            DxvkDevice*               device,
+      const std::string&              path);
+
+    ~DxvkStatsExporter();
+
+    /**
+     * \brief Notifies exporter about a presented frame
+     *
+     * Cheap to call, and must be called from the
+     * thread that queues up presentation requests.
+     * \param [in] tracker Latency tracker, may be \c nullptr
+     * \param [in] frameId Frame ID
+     */
+    void notifyPresent(
+      const Rc<DxvkLatencyTracker>&   tracker,
+            uint64_t                  frameId);
+
+    /**
+     * \brief Creates exporter as specified by the environment
+     *
+     * \param [in] device Device to sample statistics from
+     * \returns Exporter, or \c nullptr if not enabled
+     */
+    static std::unique_ptr<DxvkStatsExporter> createFromEnv(
+            DxvkDevice*               device);
+
+  private:
+
+    struct FrameMarker {
+      uint64_t                          frameId  = 0u;
+      high_resolution_clock::time_point time     = { };
+      Rc<DxvkLatencyTracker>            tracker  = nullptr;
+      DxvkStatCounters                  counters;
+      std::array<DxvkMemoryStats, VK_MAX_MEMORY_HEAPS> memory = { };
+      DxvkSamplerStats                  samplers = { };
+    };
+
+    DxvkDevice*                       m_device;
+    DxvkStatsExportFormat             m_format;
+    std::ofstream                     m_file;
+
+    uint32_t                          m_heapCount = 0u;
+
+    high_resolution_clock::time_point m_startTime = high_resolution_clock::now();
+
+    dxvk::mutex                       m_mutex;
+    dxvk::condition_variable          m_cond;
+    std::array<FrameMarker, MaxPendingFrames> m_markers = { };
+    uint64_t                          m_markerRead  = 0u;
+    uint64_t                          m_markerWrite = 0u;
+    uint64_t                          m_markersDropped = 0u;
+    bool                              m_stopped = false;
+
+    dxvk::thread                      m_thread;
+
+    void runWorker();
+
+    void sampleFrame(
+            FrameMarker&              marker);
+
+    void writeHeader();
+
+    void writeCsv(
+      const FrameMarker&              marker,
+      const DxvkLatencyStats&         latency);
+
+    void writeJson(
+      const FrameMarker&              marker,
+      const DxvkLatencyStats&         latency);
+
+  };
+
+}
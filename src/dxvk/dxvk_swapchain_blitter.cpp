@@ -64,6 +64,15 @@ namespace dxvk {
     if (m_cursorBuffer)
       uploadCursorImage(ctx);
 
+    // If there is nothing to composite and the source image can be
+    // presented as-is, skip the full-screen pass and copy directly.
+    if (canCopyImage(dstView, dstRect, srcView, srcRect)) {
+      destroyHudImage();
+
+      performCopy(ctx, dstView, srcView, srcRect);
+      return;
+    }
+
     // If we can't do proper blending, render the HUD into a separate image
     bool composite = needsComposition(dstView);
 
@@ -240,6 +249,96 @@ namespace dxvk {
   }
 
 
+  void DxvkSwapchainBlitter::performCopy(
+    const Rc<DxvkCommandList>&ctx,
+    const Rc<DxvkImageView>&  dstView,
+    const Rc<DxvkImageView>&  srcView,
+          VkRect2D            srcRect) {
+    if (unlikely(m_device->debugFlags().test(DxvkDebugFlag::Capture))) {
+      ctx->cmdBeginDebugUtilsLabel(DxvkCmdBuffer::ExecBuffer,
+        vk::makeLabel(0xdcc0f0, "Swapchain copy"));
+    }
+
+    Rc<DxvkImage> dstImage = dstView->image();
+    Rc<DxvkImage> srcImage = srcView->image();
+
+    VkImageLayout dstLayout = dstImage->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    VkImageLayout srcLayout = srcImage->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+
+    std::array<VkImageMemoryBarrier2, 2u> barriers = { };
+
+    for (auto& barrier : barriers) {
+      barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+      barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    }
+
+    barriers[0u].dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barriers[0u].dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barriers[0u].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barriers[0u].newLayout = dstLayout;
+    barriers[0u].image = dstImage->handle();
+    barriers[0u].subresourceRange = dstView->imageSubresources();
+
+    barriers[1u].srcAccessMask = srcImage->info().access;
+    barriers[1u].srcStageMask = srcImage->info().stages;
+    barriers[1u].dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+    barriers[1u].dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barriers[1u].oldLayout = srcImage->info().layout;
+    barriers[1u].newLayout = srcLayout;
+    barriers[1u].image = srcImage->handle();
+    barriers[1u].subresourceRange = srcView->imageSubresources();
+
+    VkDependencyInfo depInfo = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+    depInfo.imageMemoryBarrierCount = barriers.size();
+    depInfo.pImageMemoryBarriers = barriers.data();
+
+    ctx->cmdPipelineBarrier(DxvkCmdBuffer::ExecBuffer, &depInfo);
+
+    VkImageCopy2 region = { VK_STRUCTURE_TYPE_IMAGE_COPY_2 };
+    region.srcSubresource = vk::pickSubresourceLayers(srcView->imageSubresources(), 0u);
+    region.srcSubresource.layerCount = 1u;
+    region.srcOffset = { srcRect.offset.x, srcRect.offset.y, 0 };
+    region.dstSubresource = vk::pickSubresourceLayers(dstView->imageSubresources(), 0u);
+    region.dstSubresource.layerCount = 1u;
+    region.dstOffset = { 0, 0, 0 };
+    region.extent = { srcRect.extent.width, srcRect.extent.height, 1u };
+
+    VkCopyImageInfo2 copy = { VK_STRUCTURE_TYPE_COPY_IMAGE_INFO_2 };
+    copy.srcImage = srcImage->handle();
+    copy.srcImageLayout = srcLayout;
+    copy.dstImage = dstImage->handle();
+    copy.dstImageLayout = dstLayout;
+    copy.regionCount = 1u;
+    copy.pRegions = &region;
+
+    ctx->cmdCopyImage(DxvkCmdBuffer::ExecBuffer, &copy);
+
+    // Transition both images back to their default layouts
+    barriers[0u].srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barriers[0u].srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barriers[0u].dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+    barriers[0u].dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    barriers[0u].oldLayout = dstLayout;
+    barriers[0u].newLayout = dstImage->info().layout;
+
+    barriers[1u].srcAccessMask = VK_ACCESS_2_NONE;
+    barriers[1u].srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barriers[1u].dstAccessMask = srcImage->info().access;
+    barriers[1u].dstStageMask = srcImage->info().stages;
+    barriers[1u].oldLayout = srcLayout;
+    barriers[1u].newLayout = srcImage->info().layout;
+
+    ctx->cmdPipelineBarrier(DxvkCmdBuffer::ExecBuffer, &depInfo);
+
+    if (unlikely(m_device->debugFlags().test(DxvkDebugFlag::Capture)))
+      ctx->cmdEndDebugUtilsLabel(DxvkCmdBuffer::ExecBuffer);
+
+    ctx->track(srcImage, DxvkAccess::Read);
+    ctx->track(dstImage, DxvkAccess::Write);
+  }
+
+
   void DxvkSwapchainBlitter::performDraw(
     const Rc<DxvkCommandList>&ctx,
     const Rc<DxvkImageView>&  dstView,
@@ -839,6 +938,50 @@ namespace dxvk {
   }
 
 
+  bool DxvkSwapchainBlitter::canCopyImage(
+    const Rc<DxvkImageView>&          dstView,
+          VkRect2D                    dstRect,
+    const Rc<DxvkImageView>&          srcView,
+          VkRect2D                    srcRect) const {
+    // Anything that needs to be blended or
+    // transformed requires the shader path
+    if (m_gammaView || m_cursorView || (m_hud && !m_hud->empty()))
+      return false;
+
+    const auto& dstInfo = dstView->image()->info();
+    const auto& srcInfo = srcView->image()->info();
+
+    if (srcInfo.sampleCount != VK_SAMPLE_COUNT_1_BIT
+     || srcInfo.colorSpace != dstInfo.colorSpace
+     || srcView->info().format != dstView->info().format)
+      return false;
+
+    // Copies ignore view swizzles, e.g. for formats without alpha
+    if (!util::isIdentityMapping(srcView->info().unpackSwizzle())
+     || !util::isIdentityMapping(dstView->info().unpackSwizzle()))
+      return false;
+
+    if (!(srcInfo.usage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
+     || !(dstInfo.usage & VK_IMAGE_USAGE_TRANSFER_DST_BIT))
+      return false;
+
+    // The copy must cover the entire swap image without
+    // scaling, and must not read outside the source image
+    VkExtent3D dstExtent = dstView->mipLevelExtent(0u);
+    VkExtent3D srcExtent = srcView->mipLevelExtent(0u);
+
+    if (dstRect.offset.x || dstRect.offset.y
+     || dstRect.extent.width != dstExtent.width
+     || dstRect.extent.height != dstExtent.height
+     || srcRect.extent != dstRect.extent)
+      return false;
+
+    return srcRect.offset.x >= 0 && srcRect.offset.y >= 0
+        && uint32_t(srcRect.offset.x) + srcRect.extent.width <= srcExtent.width
+        && uint32_t(srcRect.offset.y) + srcRect.extent.height <= srcExtent.height;
+  }
+
+
   bool DxvkSwapchainBlitter::needsComposition(
     const Rc<DxvkImageView>&          dstView) {
     VkColorSpaceKHR colorSpace = dstView->image()->info().colorSpace;
@@ -240,6 +240,12 @@ namespace dxvk {
     std::unordered_map<DxvkCursorPipelineKey,
       VkPipeline, DxvkHash, DxvkEq> m_cursorPipelines;
 
+    void performCopy(
+      const Rc<DxvkCommandList>&        ctx,
+      const Rc<DxvkImageView>&          dstView,
+      const Rc<DxvkImageView>&          srcView,
+            VkRect2D                    srcRect);
+
     void performDraw(
       const Rc<DxvkCommandList>&        ctx,
       const Rc<DxvkImageView>&          dstView,
@@ -290,6 +296,12 @@ namespace dxvk {
     VkPipeline getCursorPipeline(
       const DxvkCursorPipelineKey&      key);
 
+    bool canCopyImage(
+      const Rc<DxvkImageView>&          dstView,
+            VkRect2D                    dstRect,
+      const Rc<DxvkImageView>&          srcView,
+            VkRect2D                    srcRect) const;
+
     static bool needsComposition(
       const Rc<DxvkImageView>&          dstView);
 
@@ -554,6 +554,181 @@ namespace dxvk::hud {
 
 
 
+  HudFrameStatsItem::HudFrameStatsItem(float dumpInterval) {
+    if (dumpInterval > 0.0f)
+      m_dumpInterval = std::chrono::microseconds(int64_t(double(dumpInterval) * 1'000'000.0));
+  }
+
+
+  HudFrameStatsItem::~HudFrameStatsItem() {
+
+  }
+
+
+  void HudFrameStatsItem::update(dxvk::high_resolution_clock::time_point time) {
+    if (m_lastFrame != dxvk::high_resolution_clock::time_point()) {
+      auto frameTime = std::chrono::duration_cast<std::chrono::microseconds>(time - m_lastFrame);
+      addSample(uint32_t(std::clamp<int64_t>(frameTime.count(), 0, int64_t(~0u))));
+    }
+
+    m_lastFrame = time;
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(time - m_lastUpdate);
+
+    if (elapsed.count() >= UpdateInterval && m_sampleCount) {
+      uint32_t p95 = computePercentile(9500u);
+      uint32_t p99 = computePercentile(9900u);
+      uint32_t p999 = computePercentile(9990u);
+
+      m_medianString = formatTime(computePercentile(5000u));
+      m_highString = str::format(formatTime(p95), " / ", formatTime(p99), " / ", formatTime(p999));
+      m_lowsString = str::format(formatRate(p99), " / ", formatRate(p999));
+
+      m_lastUpdate = time;
+    }
+
+    if (m_dumpInterval.count() && time - m_lastDump >= m_dumpInterval) {
+      dumpStats(time);
+      m_lastDump = time;
+    }
+  }
+
+
+  HudPos HudFrameStatsItem::render(
+    const Rc<DxvkCommandList>&ctx,
+    const HudPipelineKey&     key,
+    const HudOptions&         options,
+          HudRenderer&        renderer,
+          HudPos              position) {
+    if (m_medianString.empty())
+      return position;
+
+    position.y += 16;
+
+    renderer.drawText(16, position, 0xff4040ffu, "Median:");
+    renderer.drawText(16, { position.x + 140, position.y }, 0xffffffffu, m_medianString);
+
+    position.y += 20;
+
+    renderer.drawText(16, position, 0xff4040ffu, "P95/99/99.9:");
+    renderer.drawText(16, { position.x + 140, position.y }, 0xffffffffu, m_highString);
+
+    position.y += 20;
+
+    renderer.drawText(16, position, 0xff4040ffu, "1%/0.1% low:");
+    renderer.drawText(16, { position.x + 140, position.y }, 0xffffffffu, m_lowsString);
+
+    position.y += 8;
+    return position;
+  }
+
+
+  void HudFrameStatsItem::addSample(uint32_t frameTimeUs) {
+    if (m_sampleCount == SampleCount) {
+      uint32_t oldSample = m_samples[m_sampleIndex];
+
+      m_bins[std::min(oldSample / BinWidthUs, BinCount - 1u)] -= 1u;
+      m_sampleSum -= oldSample;
+    } else {
+      m_sampleCount += 1u;
+    }
+
+    m_samples[m_sampleIndex] = frameTimeUs;
+    m_bins[std::min(frameTimeUs / BinWidthUs, BinCount - 1u)] += 1u;
+    m_sampleSum += frameTimeUs;
+
+    m_sampleIndex = (m_sampleIndex + 1u) % SampleCount;
+  }
+
+
+  uint32_t HudFrameStatsItem::computePercentile(uint32_t basisPoints) const {
+    // Number of samples that must be at or below the result
+    uint32_t target = (uint64_t(m_sampleCount) * basisPoints + 9999u) / 10000u;
+    uint32_t count = 0u;
+
+    for (uint32_t i = 0u; i < BinCount; i++) {
+      count += m_bins[i];
+
+      if (count >= std::max(target, 1u))
+        return (i + 1u) * BinWidthUs;
+    }
+
+    return BinCount * BinWidthUs;
+  }
+
+
+  void HudFrameStatsItem::dumpStats(dxvk::high_resolution_clock::time_point time) {
+    if (m_dumpFailed || !m_sampleCount)
+      return;
+
+    if (!m_dumpFile.is_open()) {
+      std::string path = Logger::getFilePath("framestats.csv");
+
+      if (path.empty()) {
+        m_dumpFailed = true;
+        return;
+      }
+
+      m_dumpFile = std::ofstream(str::topath(path.c_str()).c_str());
+
+      if (!m_dumpFile) {
+        Logger::err(str::format("Failed to open ", path));
+        m_dumpFailed = true;
+        return;
+      }
+
+      Logger::info(str::format("Writing frame time statistics to ", path));
+
+      m_dumpFile << "time,frames,avg_ms,p50_ms,p95_ms,p99_ms,p99_9_ms,low_1_fps,low_0_1_fps";
+
+      for (uint32_t i = 0u; i < BinCount; i += 20u)
+        m_dumpFile << ",lt_" << ((i + 20u) * BinWidthUs / 1000u) << "ms";
+
+      m_dumpFile << std::endl;
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(time - m_startTime);
+
+    uint32_t p99 = computePercentile(9900u);
+    uint32_t p999 = computePercentile(9990u);
+
+    m_dumpFile << (elapsed.count() / 1000) << "." << std::setfill('0') << std::setw(3) << (elapsed.count() % 1000)
+               << "," << m_sampleCount
+               << "," << formatTime(uint32_t(m_sampleSum / m_sampleCount))
+               << "," << formatTime(computePercentile(5000u))
+               << "," << formatTime(computePercentile(9500u))
+               << "," << formatTime(p99)
+               << "," << formatTime(p999)
+               << "," << formatRate(p99)
+               << "," << formatRate(p999);
+
+    // Write a coarse histogram with 2ms buckets, the
+    // last bucket also counts all longer frame times
+    for (uint32_t i = 0u; i < BinCount; i += 20u) {
+      uint32_t count = 0u;
+
+      for (uint32_t j = i; j < i + 20u; j++)
+        count += m_bins[j];
+
+      m_dumpFile << "," << count;
+    }
+
+    m_dumpFile << std::endl;
+  }
+
+
+  std::string HudFrameStatsItem::formatTime(uint32_t us) {
+    uint32_t ms = us / 100u;
+    return str::format(ms / 10u, ".", ms % 10u);
+  }
+
+
+  std::string HudFrameStatsItem::formatRate(uint32_t us) {
+    uint32_t fps = us ? (10'000'000ull / us) : 0u;
+    return str::format(fps / 10u, ".", fps % 10u);
+  }
+
+
   HudSubmissionStatsItem::HudSubmissionStatsItem(const Rc<DxvkDevice>& device)
   : m_device(device) {
 
@@ -639,8 +814,11 @@ namespace dxvk::hud {
     if (elapsed.count() >= UpdateInterval) {
       m_drawCallCount   = diffCounters.getCtr(DxvkStatCounter::CmdDrawCalls);
       m_drawCount       = diffCounters.getCtr(DxvkStatCounter::CmdDrawsMerged) + m_drawCallCount;
+      m_unoptimizedCount = diffCounters.getCtr(DxvkStatCounter::CmdDrawsUnoptimized);
       m_dispatchCount   = diffCounters.getCtr(DxvkStatCounter::CmdDispatchCalls);
+      m_dispatchAsyncCount = diffCounters.getCtr(DxvkStatCounter::CmdDispatchAsyncCalls);
       m_renderPassCount = diffCounters.getCtr(DxvkStatCounter::CmdRenderPassCount);
+      m_renderPassMergeCount = diffCounters.getCtr(DxvkStatCounter::CmdRenderPassesMerged);
       m_barrierCount    = diffCounters.getCtr(DxvkStatCounter::CmdBarrierCount);
 
       m_lastUpdate = time;
@@ -660,17 +838,31 @@ namespace dxvk::hud {
       ? str::format(m_drawCallCount, " (", m_drawCount, ")")
       : str::format(m_drawCallCount);
 
+    std::string dispatchCount = m_dispatchAsyncCount
+      ? str::format(m_dispatchCount, " (", m_dispatchAsyncCount, " async)")
+      : str::format(m_dispatchCount);
+
+    std::string renderPassCount = m_renderPassMergeCount
+      ? str::format(m_renderPassCount, " (", m_renderPassMergeCount, " merged)")
+      : str::format(m_renderPassCount);
+
     position.y += 16;
     renderer.drawText(16, position, 0xffff8040, "Draw calls:");
     renderer.drawText(16, { position.x + 192, position.y }, 0xffffffffu, drawCount);
+
+    if (m_unoptimizedCount) {
+      position.y += 20;
+      renderer.drawText(16, position, 0xffff8040, "Unoptimized:");
+      renderer.drawText(16, { position.x + 192, position.y }, 0xffffffffu, str::format(m_unoptimizedCount));
+    }
     
     position.y += 20;
     renderer.drawText(16, position, 0xffff8040, "Dispatch calls:");
-    renderer.drawText(16, { position.x + 192, position.y }, 0xffffffffu, str::format(m_dispatchCount));
+    renderer.drawText(16, { position.x + 192, position.y }, 0xffffffffu, dispatchCount);
     
     position.y += 20;
     renderer.drawText(16, position, 0xffff8040, "Render passes:");
-    renderer.drawText(16, { position.x + 192, position.y }, 0xffffffffu, str::format(m_renderPassCount));
+    renderer.drawText(16, { position.x + 192, position.y }, 0xffffffffu, renderPassCount);
     
     position.y += 20;
     renderer.drawText(16, position, 0xffff8040, "Barriers:");
@@ -698,6 +890,8 @@ namespace dxvk::hud {
     m_graphicsPipelines = counters.getCtr(DxvkStatCounter::PipeCountGraphics);
     m_graphicsLibraries = counters.getCtr(DxvkStatCounter::PipeCountLibrary);
     m_computePipelines  = counters.getCtr(DxvkStatCounter::PipeCountCompute);
+    m_optimizedPipelines = counters.getCtr(DxvkStatCounter::PipeCountOptimized);
+    m_evictedPipelines  = counters.getCtr(DxvkStatCounter::PipeCountEvicted);
   }
 
 
@@ -711,6 +905,13 @@ namespace dxvk::hud {
     renderer.drawText(16, position, 0xffff40ff, "Graphics pipelines:");
     renderer.drawText(16, { position.x + 240, position.y }, 0xffffffffu, str::format(m_graphicsPipelines));
 
+    if (m_evictedPipelines) {
+      position.y += 20;
+      renderer.drawText(16, position, 0xffff40ff, "Optimized pipelines:");
+      renderer.drawText(16, { position.x + 240, position.y }, 0xffffffffu,
+        str::format(m_optimizedPipelines, " (", m_evictedPipelines, " evicted)"));
+    }
+
     if (m_graphicsLibraries) {
       position.y += 20;
       renderer.drawText(16, position, 0xffff40ff, "Graphics shaders:");
@@ -754,6 +955,8 @@ namespace dxvk::hud {
       m_descriptorHeapUsed = m_descriptorHeapMax;
       m_descriptorHeapMax = 0u;
 
+      m_samplerStats = m_device->getSamplerStats();
+
       m_lastUpdate = time;
     }
 
@@ -802,6 +1005,11 @@ namespace dxvk::hud {
       renderer.drawText(16, { position.x + 216, position.y }, 0xffffffffu, str::format(m_copyThreadLoad, "%"));
     }
 
+    position.y += 16;
+    renderer.drawText(16, position, 0xff8040ff, "Samplers:");
+    renderer.drawText(16, { position.x + 216, position.y }, 0xffffffffu,
+      str::format(m_samplerStats.liveCount, " (", m_samplerStats.cachedCount, " cached)"));
+
     position.y += 8;
     return position;
   }
@@ -1031,7 +1239,7 @@ namespace dxvk::hud {
     DxvkResourceBufferInfo drawDescriptor = { };
     DxvkResourceBufferInfo dataDescriptor = { };
 
-    updateDataBuffer(ctx, drawDescriptor, dataDescriptor);
+    updateDataBuffer(ctx, renderer, drawDescriptor, dataDescriptor);
 
     // Bind resources
     std::array<DxvkDescriptorWrite, 2u> descriptors = { };
@@ -1058,54 +1266,29 @@ namespace dxvk::hud {
       VK_PIPELINE_BIND_POINT_GRAPHICS, pipelines.visualize);
     ctx->cmdDraw(4, m_drawInfos.size(), 0, 0);
 
-    // Track data buffer lifetime
-    ctx->track(m_dataBuffer, DxvkAccess::Read);
-
     m_drawInfos.clear();
   }
 
 
   void HudMemoryDetailsItem::updateDataBuffer(
     const Rc<DxvkCommandList>&ctx,
+          HudRenderer&        renderer,
           DxvkResourceBufferInfo& drawDescriptor,
           DxvkResourceBufferInfo& dataDescriptor) {
     size_t drawInfoSize = m_drawInfos.size() * sizeof(DrawInfo);
-    size_t drawInfoSizeAligned = align(drawInfoSize, 256u);
-
     size_t chunkDataSize = m_stats.pageMasks.size() * sizeof(uint32_t);
-    size_t chunkDataSizeAligned = align(chunkDataSize, 256u);
-
-    size_t bufferSize = align(drawInfoSizeAligned + chunkDataSizeAligned, 2048u);
-
-    if (!m_dataBuffer || m_dataBuffer->info().size < bufferSize) {
-      DxvkBufferCreateInfo bufferInfo;
-      bufferInfo.size = bufferSize;
-      bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-      bufferInfo.access = VK_ACCESS_SHADER_READ_BIT;
-      bufferInfo.stages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-      bufferInfo.debugName = "HUD memory data";
-
-      m_dataBuffer = m_device->createBuffer(bufferInfo,
-        VK_MEMORY_HEAP_DEVICE_LOCAL_BIT |
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    } else {
-      // Ensure we can update the buffer without overriding live data
-      auto allocation = m_dataBuffer->assignStorage(m_dataBuffer->allocateStorage());
-      ctx->track(std::move(allocation));
-    }
 
-    // Update draw infos and pad unused area with zeroes
-    std::memcpy(m_dataBuffer->mapPtr(0), m_drawInfos.data(), drawInfoSize);
-    std::memset(m_dataBuffer->mapPtr(drawInfoSize), 0, drawInfoSizeAligned - drawInfoSize);
+    // Write draw infos and chunk data to the shared HUD data buffer,
+    // which takes care of padding and renaming the buffer as needed.
+    HudDataSlice drawSlice = renderer.allocData(ctx, drawInfoSize);
+    std::memcpy(drawSlice.mapPtr, m_drawInfos.data(), drawInfoSize);
 
-    // Update chunk data and pad with zeroes
-    std::memcpy(m_dataBuffer->mapPtr(drawInfoSizeAligned), m_stats.pageMasks.data(), chunkDataSize);
-    std::memset(m_dataBuffer->mapPtr(drawInfoSizeAligned + chunkDataSize), 0, chunkDataSizeAligned - chunkDataSize);
+    HudDataSlice dataSlice = renderer.allocData(ctx, chunkDataSize);
+    std::memcpy(dataSlice.mapPtr, m_stats.pageMasks.data(), chunkDataSize);
 
     // Write back descriptors
-    drawDescriptor = m_dataBuffer->getSliceInfo(0u, drawInfoSizeAligned);
-    dataDescriptor = m_dataBuffer->getSliceInfo(drawInfoSizeAligned, chunkDataSizeAligned);
+    drawDescriptor = drawSlice.buffer;
+    dataDescriptor = dataSlice.buffer;
   }
 
 
@@ -1402,6 +1585,10 @@ namespace dxvk::hud {
     if (stats.frameLatency.count()) {
       m_accumStats.frameLatency += stats.frameLatency;
       m_accumStats.sleepDuration += stats.sleepDuration;
+      m_accumStats.cpuTime += stats.cpuTime;
+      m_accumStats.csTime += stats.csTime;
+      m_accumStats.gpuTime += stats.gpuTime;
+      m_accumStats.presentDelay += stats.presentDelay;
 
       m_accumFrames += 1u;
     } else {
@@ -1424,6 +1611,21 @@ namespace dxvk::hud {
         m_latencyString = str::format(latency / 10, ".", latency % 10, " ms");
         m_sleepString = str::format(sleep / 10, ".", sleep % 10, " ms");
 
+        if (m_accumStats.gpuTime.count()) {
+          uint32_t cpu = (m_accumStats.cpuTime / m_accumFrames).count() / 100u;
+          uint32_t cs = (m_accumStats.csTime / m_accumFrames).count() / 100u;
+          uint32_t gpu = (m_accumStats.gpuTime / m_accumFrames).count() / 100u;
+          uint32_t present = (m_accumStats.presentDelay / m_accumFrames).count() / 100u;
+
+          m_stagesString = str::format(
+            cpu / 10, ".", cpu % 10, " / ",
+            cs / 10, ".", cs % 10, " / ",
+            gpu / 10, ".", gpu % 10, " / ",
+            present / 10, ".", present % 10, " ms");
+        } else {
+          m_stagesString.clear();
+        }
+
         m_accumStats = { };
         m_accumFrames = 0u;
 
@@ -1431,6 +1633,7 @@ namespace dxvk::hud {
       } else {
         m_latencyString = "--";
         m_sleepString = "--";
+        m_stagesString.clear();
 
         if (m_invalidUpdates < MaxInvalidUpdates)
           m_invalidUpdates += 1u;
@@ -1460,6 +1663,93 @@ namespace dxvk::hud {
     renderer.drawText(16, position, 0xffff60a0u, "Sleep: ");
     renderer.drawText(16, { position.x + 108, position.y }, 0xffffffffu, m_sleepString);
 
+    if (!m_stagesString.empty()) {
+      position.y += 20;
+
+      renderer.drawText(16, position, 0xffff60a0u, "Stages: ");
+      renderer.drawText(16, { position.x + 108, position.y }, 0xffffffffu, m_stagesString);
+
+      position.y += 20;
+
+      renderer.drawText(12, position, 0xff808080u, "CPU / CS / GPU / present");
+    }
+
+    position.y += 8;
+    return position;
+  }
+
+
+
+  HudFramePacingItem::HudFramePacingItem() {
+
+  }
+
+
+  HudFramePacingItem::~HudFramePacingItem() {
+
+  }
+
+
+  void HudFramePacingItem::accumulateStats(const FpsLimiterStats& stats) {
+    std::lock_guard lock(m_mutex);
+
+    m_accumStats.lockedFrames += stats.lockedFrames;
+    m_accumStats.phaseErrorSum += stats.phaseErrorSum;
+    m_accumStats.phaseErrorMax = std::max(m_accumStats.phaseErrorMax, stats.phaseErrorMax);
+
+    if (stats.frameInterval.count())
+      m_accumStats.frameInterval = stats.frameInterval;
+  }
+
+
+  void HudFramePacingItem::update(dxvk::high_resolution_clock::time_point time) {
+    uint64_t ticks = std::chrono::duration_cast<std::chrono::microseconds>(time - m_lastUpdate).count();
+
+    if (ticks >= UpdateInterval) {
+      std::lock_guard lock(m_mutex);
+
+      if (m_accumStats.lockedFrames) {
+        uint32_t avg = (m_accumStats.phaseErrorSum / m_accumStats.lockedFrames).count() / 100u;
+        uint32_t max = m_accumStats.phaseErrorMax.count() / 100u;
+        uint32_t interval = m_accumStats.frameInterval.count() / 100u;
+
+        m_errorString = str::format(avg / 10, ".", avg % 10, " ms (max ", max / 10, ".", max % 10, " ms)");
+        m_intervalString = str::format(interval / 10, ".", interval % 10, " ms");
+
+        m_invalidUpdates = 0u;
+      } else {
+        m_errorString = "--";
+        m_intervalString = "--";
+
+        if (m_invalidUpdates < MaxInvalidUpdates)
+          m_invalidUpdates += 1u;
+      }
+
+      m_accumStats = { };
+      m_lastUpdate = time;
+    }
+  }
+
+
+  HudPos HudFramePacingItem::render(
+    const Rc<DxvkCommandList>&ctx,
+    const HudPipelineKey&     key,
+    const HudOptions&         options,
+          HudRenderer&        renderer,
+          HudPos              position) {
+    if (m_invalidUpdates >= MaxInvalidUpdates)
+      return position;
+
+    position.y += 16;
+
+    renderer.drawText(16, position, 0xffff60a0u, "Pacing: ");
+    renderer.drawText(16, { position.x + 108, position.y }, 0xffffffffu, m_errorString);
+
+    position.y += 20;
+
+    renderer.drawText(16, position, 0xffff60a0u, "Interval: ");
+    renderer.drawText(16, { position.x + 108, position.y }, 0xffffffffu, m_intervalString);
+
     position.y += 8;
     return position;
   }
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <array>
+#include <fstream>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "../../util/util_fps_limiter.h"
 #include "../../util/util_time.h"
 
 #include "../dxvk_gpu_query.h"
@@ -349,6 +352,75 @@ namespace dxvk::hud {
   };
 
 
+  /**
+   * \brief HUD item to display frame time percentiles
+   *
+   * Keeps a ring of recent frame times along with a fine-grained
+   * histogram that is updated incrementally as frames enter and
+   * leave the ring, so that percentiles can be computed cheaply.
+   * Optionally dumps summaries to a CSV file at fixed intervals.
+   */
+  class HudFrameStatsItem : public HudItem {
+    constexpr static int64_t UpdateInterval = 500'000;
+
+    constexpr static uint32_t SampleCount = 4096u;
+    constexpr static uint32_t BinWidthUs  = 100u;
+    constexpr static uint32_t BinCount    = 2500u;
+  public:
+
+    HudFrameStatsItem(float dumpInterval);
+
+    ~HudFrameStatsItem();
+
+    void update(dxvk::high_resolution_clock::time_point time);
+
+    HudPos render(
+      const Rc<DxvkCommandList>&ctx,
+      const HudPipelineKey&     key,
+      const HudOptions&         options,
+            HudRenderer&        renderer,
+            HudPos              position);
+
+  private:
+
+    std::array<uint32_t, SampleCount> m_samples = { };
+    std::array<uint16_t, BinCount>    m_bins    = { };
+
+    uint32_t m_sampleIndex  = 0u;
+    uint32_t m_sampleCount  = 0u;
+    uint64_t m_sampleSum    = 0u;
+
+    dxvk::high_resolution_clock::time_point m_lastFrame = { };
+    dxvk::high_resolution_clock::time_point m_lastUpdate
+      = dxvk::high_resolution_clock::now();
+
+    dxvk::high_resolution_clock::time_point m_startTime
+      = dxvk::high_resolution_clock::now();
+    dxvk::high_resolution_clock::time_point m_lastDump
+      = dxvk::high_resolution_clock::now();
+
+    std::chrono::microseconds m_dumpInterval = std::chrono::microseconds(0u);
+
+    std::ofstream m_dumpFile;
+    bool          m_dumpFailed = false;
+
+    std::string m_medianString;
+    std::string m_highString;
+    std::string m_lowsString;
+
+    void addSample(uint32_t frameTimeUs);
+
+    uint32_t computePercentile(uint32_t basisPoints) const;
+
+    void dumpStats(dxvk::high_resolution_clock::time_point time);
+
+    static std::string formatTime(uint32_t us);
+
+    static std::string formatRate(uint32_t us);
+
+  };
+
+
   /**
    * \brief HUD item to display queue statistics
    */
@@ -418,8 +490,11 @@ namespace dxvk::hud {
 
     uint64_t          m_drawCallCount   = 0;
     uint64_t          m_drawCount       = 0;
+    uint64_t          m_unoptimizedCount = 0;
     uint64_t          m_dispatchCount   = 0;
+    uint64_t          m_dispatchAsyncCount = 0;
     uint64_t          m_renderPassCount = 0;
+    uint64_t          m_renderPassMergeCount = 0;
     uint64_t          m_barrierCount    = 0;
 
     dxvk::high_resolution_clock::time_point m_lastUpdate
@@ -455,6 +530,8 @@ namespace dxvk::hud {
     uint64_t m_graphicsPipelines  = 0;
     uint64_t m_graphicsLibraries  = 0;
     uint64_t m_computePipelines   = 0;
+    uint64_t m_optimizedPipelines = 0;
+    uint64_t m_evictedPipelines   = 0;
 
   };
 
@@ -497,6 +574,8 @@ namespace dxvk::hud {
     uint64_t m_copyThreadBusyTicks = 0;
     uint32_t m_copyThreadLoad      = 0u;
 
+    DxvkSamplerStats m_samplerStats = { };
+
     high_resolution_clock::time_point m_lastUpdate = { };
 
   };
@@ -578,7 +657,6 @@ namespace dxvk::hud {
 
     bool                      m_displayCacheStats = false;
 
-    Rc<DxvkBuffer>            m_dataBuffer;
     std::vector<DrawInfo>     m_drawInfos;
 
     const DxvkPipelineLayout* m_pipelineLayout = nullptr;
@@ -600,6 +678,7 @@ namespace dxvk::hud {
 
     void updateDataBuffer(
       const Rc<DxvkCommandList>&ctx,
+            HudRenderer&        renderer,
             DxvkResourceBufferInfo& drawDescriptor,
             DxvkResourceBufferInfo& dataDescriptor);
 
@@ -771,6 +850,52 @@ namespace dxvk::hud {
 
     std::string         m_latencyString;
     std::string         m_sleepString;
+    std::string         m_stagesString;
+
+    dxvk::high_resolution_clock::time_point m_lastUpdate
+      = dxvk::high_resolution_clock::now();
+
+  };
+
+
+  /**
+   * \brief Frame pacing item
+   *
+   * Displays phase error statistics of the built-in
+   * frame rate limiter while it is locked on to the
+   * display's refresh cycle.
+   */
+  class HudFramePacingItem : public HudItem {
+    constexpr static int64_t UpdateInterval = 500'000;
+
+    constexpr static uint32_t MaxInvalidUpdates = 20u;
+  public:
+
+    HudFramePacingItem();
+
+    ~HudFramePacingItem();
+
+    void accumulateStats(const FpsLimiterStats& stats);
+
+    void update(dxvk::high_resolution_clock::time_point time);
+
+    HudPos render(
+      const Rc<DxvkCommandList>&ctx,
+      const HudPipelineKey&     key,
+      const HudOptions&         options,
+            HudRenderer&        renderer,
+            HudPos              position);
+
+  private:
+
+    sync::Spinlock      m_mutex;
+
+    FpsLimiterStats     m_accumStats = { };
+
+    uint32_t            m_invalidUpdates = MaxInvalidUpdates;
+
+    std::string         m_errorString;
+    std::string         m_intervalString;
 
     dxvk::high_resolution_clock::time_point m_lastUpdate
       = dxvk::high_resolution_clock::now();
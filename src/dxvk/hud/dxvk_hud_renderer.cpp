@@ -60,6 +60,15 @@ namespace dxvk::hud {
       uploadFontResources(ctx);
     }
 
+    if (m_dataBuffer && m_dataOffset) {
+      // Discard and invalidate data buffer once per frame
+      // so that all items can safely write to it
+      auto storage = m_dataBuffer->assignStorage(Rc<DxvkResourceAllocation>(m_dataBuffer->allocateStorage()));
+      ctx->track(std::move(storage));
+    }
+
+    m_dataOffset = 0u;
+
     VkExtent3D extent = dstView->mipLevelExtent(0u);
 
     m_pushConstants.surfaceSize = { extent.width, extent.height };
@@ -86,6 +95,9 @@ namespace dxvk::hud {
   
   void HudRenderer::endFrame(
     const Rc<DxvkCommandList>&ctx) {
+    if (m_dataBuffer)
+      ctx->track(m_dataBuffer, DxvkAccess::Read);
+
     if (unlikely(m_device->debugFlags().test(DxvkDebugFlag::Capture)))
       ctx->cmdEndDebugUtilsLabel(DxvkCmdBuffer::ExecBuffer);
   }
@@ -119,83 +131,45 @@ namespace dxvk::hud {
     if (m_textDraws.empty())
       return;
 
-    // Align text size so that we're guaranteed to be able to put draw
-    // parameters where we want, and can also upload data without
-    // running into perf issues due to incomplete cache lines.
-    size_t textSizeAligned = align(m_textData.size(), 256u);
-    m_textData.resize(textSizeAligned);
-
-    // We'll use indirect draws and then just use aligned subsections
-    // of the data buffer to write our draw parameters
+    // Allocate text, draw parameters and indirect draw arguments from
+    // one single slice, so that the text view can be used for the
+    // text data even if the data buffer needs to be replaced here.
+    size_t textSize = align(m_textData.size(), 256u);
     size_t drawInfoSize = align(m_textDraws.size() * sizeof(HudTextDrawInfo), 256u);
-    size_t drawArgsSize = align(m_textDraws.size() * sizeof(VkDrawIndirectCommand), 256u);
-
-    // Align buffer size to something large so we don't recreate it all the time
-    size_t bufferSize = align(textSizeAligned + drawInfoSize + drawArgsSize, 2048u);
-
-    if (!m_textBuffer || m_textBuffer->info().size < bufferSize) {
-      DxvkBufferCreateInfo textBufferInfo = { };
-      textBufferInfo.size = bufferSize;
-      textBufferInfo.usage = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
-                           | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
-                           | VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT;
-      textBufferInfo.stages = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT
-                            | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
-      textBufferInfo.access = VK_ACCESS_SHADER_READ_BIT
-                            | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
-      textBufferInfo.debugName = "HUD text buffer";
-
-      m_textBuffer = m_device->createBuffer(textBufferInfo,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-      DxvkBufferViewKey textViewInfo = { };
-      textViewInfo.format = VK_FORMAT_R8_UINT;
-      textViewInfo.offset = 0u;
-      textViewInfo.size = bufferSize;
-      textViewInfo.usage = VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT;
-
-      m_textBufferView = m_textBuffer->createView(textViewInfo);
-    } else {
-      // Discard and invalidate buffer so we can safely update it
-      auto storage = m_textBuffer->assignStorage(Rc<DxvkResourceAllocation>(m_textBuffer->allocateStorage()));
-      ctx->track(std::move(storage));
-    }
-
-    // Upload aligned text data in such a way that we write full cache lines
-    std::memcpy(m_textBuffer->mapPtr(0), m_textData.data(), textSizeAligned);
+    size_t drawArgsSize = m_textDraws.size() * sizeof(VkDrawIndirectCommand);
 
-    // Upload draw parameters and pad aligned region with zeroes
-    size_t drawInfoCopySize = m_textDraws.size() * sizeof(HudTextDrawInfo);
-    std::memcpy(m_textBuffer->mapPtr(textSizeAligned), m_textDraws.data(), drawInfoCopySize);
-    std::memset(m_textBuffer->mapPtr(textSizeAligned + drawInfoCopySize), 0, drawInfoSize - drawInfoCopySize);
+    HudDataSlice slice = allocData(ctx, textSize + drawInfoSize + drawArgsSize);
 
-    // Emit indirect draw parameters
-    size_t drawArgWriteSize = m_textDraws.size() * sizeof(VkDrawIndirectCommand);
-    size_t drawArgOffset = textSizeAligned + drawInfoSize;
+    auto dataPtr = reinterpret_cast<char*>(slice.mapPtr);
+    std::memcpy(dataPtr, m_textData.data(), m_textData.size());
+    std::memset(dataPtr + m_textData.size(), 0, textSize - m_textData.size());
 
-    auto drawArgs = reinterpret_cast<VkDrawIndirectCommand*>(m_textBuffer->mapPtr(drawArgOffset));
+    // Text offsets are relative to the start of the text view
+    auto drawInfos = reinterpret_cast<HudTextDrawInfo*>(dataPtr + textSize);
+    auto drawArgs = reinterpret_cast<VkDrawIndirectCommand*>(dataPtr + textSize + drawInfoSize);
 
     for (size_t i = 0; i < m_textDraws.size(); i++) {
+      HudTextDrawInfo drawInfo = m_textDraws[i];
+      drawInfo.textOffset += uint32_t(slice.offset);
+      drawInfos[i] = drawInfo;
+
       drawArgs[i].vertexCount = 6u * m_textDraws[i].textLength;
       drawArgs[i].instanceCount = 1u;
       drawArgs[i].firstVertex = 0u;
       drawArgs[i].firstInstance = 0u;
     }
 
-    std::memset(m_textBuffer->mapPtr(drawArgOffset + drawArgWriteSize), 0, drawArgsSize - drawArgWriteSize);
+    std::memset(&drawInfos[m_textDraws.size()], 0, drawInfoSize - m_textDraws.size() * sizeof(HudTextDrawInfo));
 
     // Draw the actual text
-    DxvkResourceBufferInfo textBufferInfo = m_textBuffer->getSliceInfo(textSizeAligned, drawInfoSize);
-    DxvkResourceBufferInfo drawBufferInfo = m_textBuffer->getSliceInfo(drawArgOffset, drawArgWriteSize);
+    DxvkResourceBufferInfo textBufferInfo = m_dataBuffer->getSliceInfo(slice.offset + textSize, drawInfoSize);
+    DxvkResourceBufferInfo drawBufferInfo = m_dataBuffer->getSliceInfo(slice.offset + textSize + drawInfoSize, drawArgsSize);
 
     drawTextIndirect(ctx, getPipelineKey(dstView),
       drawBufferInfo, textBufferInfo,
-      m_textBufferView, m_textDraws.size());
+      m_dataBufferView, m_textDraws.size());
 
     // Ensure all used resources are kept alive
-    ctx->track(m_textBuffer, DxvkAccess::Read);
     ctx->track(m_fontBuffer, DxvkAccess::Read);
     ctx->track(m_fontTexture, DxvkAccess::Read);
     ctx->track(m_fontSampler);
@@ -206,6 +180,35 @@ namespace dxvk::hud {
   }
 
 
+  HudDataSlice HudRenderer::allocData(
+    const Rc<DxvkCommandList>&ctx,
+          VkDeviceSize        size) {
+    VkDeviceSize alignedSize = align(std::max<VkDeviceSize>(size, 1u), 256u);
+
+    if (!m_dataBuffer || m_dataOffset + alignedSize > m_dataBuffer->info().size) {
+      // Keep the old buffer alive for any draws that were already
+      // recorded, and size the new one so that everything allocated
+      // this frame fits. This will only happen a few times.
+      if (m_dataBuffer)
+        ctx->track(m_dataBuffer, DxvkAccess::Read);
+
+      createDataBuffer(std::max(DataBufferSize, 2u * (m_dataOffset + alignedSize)));
+      m_dataOffset = 0u;
+    }
+
+    HudDataSlice slice = { };
+    slice.offset = m_dataOffset;
+    slice.buffer = m_dataBuffer->getSliceInfo(m_dataOffset, alignedSize);
+    slice.mapPtr = m_dataBuffer->mapPtr(m_dataOffset);
+
+    // Pad with zeroes so that we always write full cache lines
+    std::memset(m_dataBuffer->mapPtr(m_dataOffset + size), 0, alignedSize - size);
+
+    m_dataOffset += alignedSize;
+    return slice;
+  }
+
+
   void HudRenderer::drawTextIndirect(
     const Rc<DxvkCommandList>&ctx,
     const HudPipelineKey&     key,
@@ -339,6 +342,35 @@ namespace dxvk::hud {
   }
 
 
+  void HudRenderer::createDataBuffer(
+          VkDeviceSize        size) {
+    DxvkBufferCreateInfo dataBufferInfo = { };
+    dataBufferInfo.size = align(size, 2048u);
+    dataBufferInfo.usage = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
+                         | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+                         | VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT;
+    dataBufferInfo.stages = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT
+                          | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT
+                          | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    dataBufferInfo.access = VK_ACCESS_SHADER_READ_BIT
+                          | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    dataBufferInfo.debugName = "HUD data buffer";
+
+    m_dataBuffer = m_device->createBuffer(dataBufferInfo,
+      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+      VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    DxvkBufferViewKey dataViewInfo = { };
+    dataViewInfo.format = VK_FORMAT_R8_UINT;
+    dataViewInfo.offset = 0u;
+    dataViewInfo.size = dataBufferInfo.size;
+    dataViewInfo.usage = VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT;
+
+    m_dataBufferView = m_dataBuffer->createView(dataViewInfo);
+  }
+
+
   void HudRenderer::uploadFontResources(
     const Rc<DxvkCommandList>&ctx) {
     size_t bufferDataSize = sizeof(HudFontGpuData);
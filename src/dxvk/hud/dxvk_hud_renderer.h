@@ -40,6 +40,18 @@ namespace dxvk::hud {
   };
 
 
+  /**
+   * \brief Mapped slice of HUD data buffer
+   *
+   * Only valid for the frame it was allocated in.
+   */
+  struct HudDataSlice {
+    VkDeviceSize            offset = 0u;
+    DxvkResourceBufferInfo  buffer = { };
+    void*                   mapPtr = nullptr;
+  };
+
+
   struct HudPushConstants {
     VkExtent2D surfaceSize;
     float opacity;
@@ -106,6 +118,21 @@ namespace dxvk::hud {
             uint32_t            color,
       const std::string&        text);
 
+    /**
+     * \brief Allocates per-frame HUD data
+     *
+     * Suballocates from a single host-visible buffer that is
+     * shared by all HUD items and the text renderer, and only
+     * gets renamed once per frame. Unused bytes at the end of
+     * the aligned allocation are zero-initialized.
+     * \param [in] ctx Command list
+     * \param [in] size Number of bytes to allocate
+     * \returns Mapped buffer slice
+     */
+    HudDataSlice allocData(
+      const Rc<DxvkCommandList>&ctx,
+            VkDeviceSize        size);
+
     void drawTextIndirect(
       const Rc<DxvkCommandList>&ctx,
       const HudPipelineKey&     key,
@@ -139,8 +166,9 @@ namespace dxvk::hud {
     Rc<DxvkImageView>       m_fontTextureView;
     Rc<DxvkSampler>         m_fontSampler;
 
-    Rc<DxvkBuffer>          m_textBuffer;
-    Rc<DxvkBufferView>      m_textBufferView;
+    Rc<DxvkBuffer>          m_dataBuffer;
+    Rc<DxvkBufferView>      m_dataBufferView;
+    VkDeviceSize            m_dataOffset = 0u;
 
     std::vector<HudTextDrawInfo>  m_textDraws;
     std::vector<char>             m_textData;
@@ -154,6 +182,9 @@ namespace dxvk::hud {
 
     void createFontResources();
 
+    void createDataBuffer(
+            VkDeviceSize        size);
+
     void uploadFontResources(
       const Rc<DxvkCommandList>&ctx);
 
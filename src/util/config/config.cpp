@@ -1,5 +1,7 @@
 #include <array>
+#include <cstring>
 #include <fstream>
+#include <locale>
 #include <sstream>
 #include <iostream>
 #include <regex>
@@ -1425,24 +1427,214 @@ namespace dxvk {
   };
 
 
-  const Config* findProfile(const ProfileList& profiles, const std::string& appName) {
-    auto appConfig = std::find_if(profiles.begin(), profiles.end(),
-      [&appName] (const std::pair<const char*, Config>& pair) {
-        // With certain locales, regex parsing will simply crash. Using regex::imbue
-        // does not resolve this; only the global locale seems to matter here. Catch
-        // bad_alloc errors to work around this for now.
-        try {
-          std::regex expr(pair.first, std::regex::extended | std::regex::icase);
-          return std::regex_search(appName, expr);
-        } catch (const std::bad_alloc& e) {
-          Logger::err(str::format("Failed to parse regular expression: ", pair.first));
-          return false;
+  using ProfileLiteralList = std::vector<std::vector<std::string>>;
+
+
+  size_t skipBracketExpression(const char* pattern, size_t i) {
+    // Returns the index past the closing bracket, or 0 if the
+    // expression is malformed. A closing bracket at the start
+    // of the expression is treated as a literal character.
+    i += 1u;
+
+    if (pattern[i] == '^')
+      i += 1u;
+
+    if (pattern[i] == ']')
+      i += 1u;
+
+    while (pattern[i] && pattern[i] != ']') {
+      if (pattern[i] == '[' && (pattern[i + 1u] == ':' || pattern[i + 1u] == '.' || pattern[i + 1u] == '=')) {
+        char delim = pattern[i + 1u];
+        i += 2u;
+
+        while (pattern[i] && !(pattern[i] == delim && pattern[i + 1u] == ']'))
+          i += 1u;
+
+        if (!pattern[i])
+          return 0u;
+
+        i += 2u;
+      } else {
+        i += 1u;
+      }
+    }
+
+    return pattern[i] ? i + 1u : 0u;
+  }
+
+
+  size_t skipGroup(const char* pattern, size_t i) {
+    // Returns the index past the closing parenthesis,
+    // or 0 if the expression is malformed.
+    uint32_t depth = 0u;
+
+    while (pattern[i]) {
+      char c = pattern[i];
+
+      if (c == '\\') {
+        if (!pattern[i + 1u])
+          return 0u;
+
+        i += 2u;
+      } else if (c == '[') {
+        i = skipBracketExpression(pattern, i);
+
+        if (!i)
+          return 0u;
+      } else {
+        i += 1u;
+
+        if (c == '(')
+          depth += 1u;
+
+        if (c == ')' && !(--depth))
+          return i;
+      }
+    }
+
+    return 0u;
+  }
+
+
+  std::vector<std::string> getRequiredLiterals(const char* pattern) {
+    // Conservatively extracts strings that must occur in any string matched by
+    // the given extended regular expression. Only plain literal characters at
+    // the top level of the expression are considered, so that we never reject
+    // an app name that the regular expression itself would match.
+    std::vector<std::string> result;
+    std::string literal;
+
+    auto flush = [&result, &literal] {
+      if (!literal.empty())
+        result.push_back(std::move(literal));
+
+      literal.clear();
+    };
+
+    size_t i = 0u;
+
+    while (pattern[i]) {
+      char c = pattern[i];
+
+      switch (c) {
+        case '|':
+          // Alternatives at the top level, nothing is required
+          return std::vector<std::string>();
+
+        case '(':
+        case '[':
+          flush();
+          i = c == '(' ? skipGroup(pattern, i) : skipBracketExpression(pattern, i);
+
+          if (!i)
+            return std::vector<std::string>();
+          break;
+
+        case '?':
+        case '*':
+        case '+':
+        case '{':
+          // The quantifier applies to the preceeding character
+          // if it was a literal, so that is no longer required
+          if (!literal.empty())
+            literal.pop_back();
+
+          flush();
+
+          if (c == '{') {
+            while (pattern[i] && pattern[i] != '}')
+              i += 1u;
+
+            if (!pattern[i])
+              return std::vector<std::string>();
+          }
+
+          i += 1u;
+          break;
+
+        case '\\':
+          if (pattern[i + 1u] && std::strchr("\\.[]()|^$*+?{}", pattern[i + 1u])) {
+            literal.push_back(pattern[i + 1u]);
+          } else {
+            flush();
+
+            if (!pattern[i + 1u])
+              return result;
+          }
+
+          i += 2u;
+          break;
+
+        case '.':
+        case '^':
+        case '$':
+        case ')':
+        case ']':
+        case '}':
+          flush();
+          i += 1u;
+          break;
+
+        default:
+          literal.push_back(c);
+          i += 1u;
+      }
+    }
+
+    flush();
+    return result;
+  }
+
+
+  ProfileLiteralList getProfileLiterals(const ProfileList& profiles) {
+    ProfileLiteralList result;
+    result.reserve(profiles.size());
+
+    for (const auto& pair : profiles)
+      result.push_back(getRequiredLiterals(pair.first));
+
+    return result;
+  }
+
+
+  const Config* findProfile(const ProfileList& profiles, const ProfileLiteralList& literals, const std::string& appName) {
+    // Fold case the same way that std::regex does with icase, so
+    // that the literal pre-check never rejects an actual match.
+    const auto& ctype = std::use_facet<std::ctype<char>>(std::locale());
+
+    std::string foldedName = appName;
+    ctype.tolower(foldedName.data(), foldedName.data() + foldedName.size());
+
+    for (size_t i = 0u; i < profiles.size(); i++) {
+      bool canMatch = true;
+
+      for (const auto& literal : literals[i]) {
+        std::string foldedLiteral = literal;
+        ctype.tolower(foldedLiteral.data(), foldedLiteral.data() + foldedLiteral.size());
+
+        if (foldedName.find(foldedLiteral) == std::string::npos) {
+          canMatch = false;
+          break;
         }
-      });
+      }
 
-    return appConfig != profiles.end()
-      ? &appConfig->second
-      : nullptr;
+      if (!canMatch)
+        continue;
+
+      // With certain locales, regex parsing will simply crash. Using regex::imbue
+      // does not resolve this; only the global locale seems to matter here. Catch
+      // bad_alloc errors to work around this for now.
+      try {
+        std::regex expr(profiles[i].first, std::regex::extended | std::regex::icase);
+
+        if (std::regex_search(appName, expr))
+          return &profiles[i].second;
+      } catch (const std::bad_alloc& e) {
+        Logger::err(str::format("Failed to parse regular expression: ", profiles[i].first));
+      }
+    }
+
+    return nullptr;
   }
 
 
@@ -1721,11 +1913,15 @@ namespace dxvk {
   Config Config::getAppConfig(const std::string& appName) {
     const Config* config = nullptr;
 
-    if (env::getEnvVar("SteamDeck") == "1")
-      config = findProfile(g_deckProfiles, appName);
+    if (env::getEnvVar("SteamDeck") == "1") {
+      static const ProfileLiteralList s_deckLiterals = getProfileLiterals(g_deckProfiles);
+      config = findProfile(g_deckProfiles, s_deckLiterals, appName);
+    }
 
-    if (!config)
-      config = findProfile(g_profiles, appName);
+    if (!config) {
+      static const ProfileLiteralList s_literals = getProfileLiterals(g_profiles);
+      config = findProfile(g_profiles, s_literals, appName);
+    }
 
     if (!config)
       config = findHashedProfile(g_hashedProfiles, appName);
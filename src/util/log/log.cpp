@@ -1,3 +1,4 @@
+#include <exception>
 #include <utility>
 
 #include "log.h"
@@ -5,14 +6,57 @@
 #include "../util_env.h"
 
 namespace dxvk {
+
+#ifdef _WIN32
+  static LPTOP_LEVEL_EXCEPTION_FILTER g_prevExceptionFilter = nullptr;
+#else
+  static const std::array<int, 5> g_crashSignals = {{
+    SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT,
+  }};
+
+  static std::array<struct sigaction, 5> g_prevSignalActions = { };
+  static std::terminate_handler g_prevTerminateHandler = nullptr;
+#endif
   
   Logger::Logger(const std::string& fileName)
-  : m_minLevel(getMinLogLevel()), m_fileName(fileName) {
+  : m_minLevel(getMinLogLevel()), m_fileName(fileName),
+    m_async(env::getEnvVar("DXVK_LOG_ASYNC") == "1") {
+    if (m_async) {
+      m_queue = std::make_unique<std::array<QueueEntry, QueueSize>>();
 
+      for (uint32_t i = 0; i < QueueSize; i++)
+        (*m_queue)[i].sequence.store(i, std::memory_order_relaxed);
+    }
   }
   
   
-  Logger::~Logger() { }
+  Logger::~Logger() {
+    if (!m_threadStarted.load(std::memory_order_acquire))
+      return;
+
+    removeCrashHandlers();
+
+    if (this_thread::isInModuleDetachment()) {
+      // The worker may have been terminated at any point,
+      // including while holding the lock, so don't wait
+      // for it and only write out what we safely can.
+      m_thread.detach();
+
+      std::unique_lock lock(m_mutex, std::try_to_lock);
+
+      if (lock) {
+        drainQueue();
+        flushRepeats(true);
+      }
+    } else {
+      { std::lock_guard lock(m_mutex);
+        m_stopped = true;
+      }
+
+      m_cond.notify_one();
+      m_thread.join();
+    }
+  }
   
   
   void Logger::trace(const std::string& message) {
@@ -43,85 +87,340 @@ namespace dxvk {
   void Logger::log(LogLevel level, const std::string& message) {
     s_instance.emitMsg(level, message);
   }
+
+
+  void Logger::flush() {
+    if (!s_instance.m_async)
+      return;
+
+    std::lock_guard lock(s_instance.m_mutex);
+    s_instance.drainQueue();
+    s_instance.flushRepeats(true);
+  }
   
   
   void Logger::emitMsg(LogLevel level, const std::string& message) {
-    if (level >= m_minLevel) {
+    if (level < m_minLevel)
+      return;
+
+    if (m_async && level < LogLevel::Error) {
+      if (!m_threadStarted.load(std::memory_order_acquire))
+        startThread();
+
+      if (enqueueMsg(level, message))
+        m_cond.notify_one();
+      else
+        m_queueDropped.fetch_add(1u, std::memory_order_relaxed);
+    } else {
       std::lock_guard<dxvk::mutex> lock(m_mutex);
-      
-      static std::array<const char*, 5> s_prefixes
-        = {{ "trace: ", "debug: ", "info:  ", "warn:  ", "err:   " }};
-      
-      const char* prefix = s_prefixes.at(static_cast<uint32_t>(level));
 
-      if (!std::exchange(m_initialized, true)) {
-#ifdef _WIN32
-        HMODULE ntdll = GetModuleHandleA("ntdll.dll");
+      // Preserve message order and make sure that everything
+      // leading up to an error ends up in the log file
+      if (m_async)
+        drainQueue();
+
+      writeMsg(level, message);
+    }
+  }
 
-        if (ntdll)
-          m_wineLogOutput = reinterpret_cast<PFN_wineLogOutput>(GetProcAddress(ntdll, "__wine_dbg_output"));
+
+  void Logger::writeMsg(LogLevel level, const std::string& message) {
+    static std::array<const char*, 5> s_prefixes
+      = {{ "trace: ", "debug: ", "info:  ", "warn:  ", "err:   " }};
+    
+    const char* prefix = s_prefixes.at(static_cast<uint32_t>(level));
+
+    if (!std::exchange(m_initialized, true)) {
+#ifdef _WIN32
+      m_wineLogOutput = getWineLogOutput();
 #endif
-        auto path = getFileName(m_fileName);
+      auto path = getFilePath(m_fileName);
 
-        if (!path.empty())
-          m_fileStream = std::ofstream(str::topath(path.c_str()).c_str());
-      }
+      if (!path.empty())
+        m_fileStream = std::ofstream(str::topath(path.c_str()).c_str());
+    }
 
-      std::stringstream stream(message);
-      std::string line;
+    std::stringstream stream(message);
+    std::string line;
 
-      while (std::getline(stream, line, '\n')) {
-        std::stringstream outstream;
-        outstream << prefix << line << std::endl;
+    while (std::getline(stream, line, '\n')) {
+      std::stringstream outstream;
+      outstream << prefix << line << std::endl;
 
-        std::string adjusted = outstream.str();
+      std::string adjusted = outstream.str();
 
-        if (!adjusted.empty()) {
+      if (!adjusted.empty()) {
 #ifdef _WIN32
-          if (m_wineLogOutput) {
-            // __wine_dbg_output tries to buffer lines up to 1020 characters
-            // including null terminator, and will cause a hang if we submit
-            // anything longer than that even in consecutive calls. Work
-            // around this by splitting long lines into multiple lines.
-            constexpr size_t MaxDebugBufferLength = 1018;
-
-            if (adjusted.size() <= MaxDebugBufferLength) {
-              m_wineLogOutput(adjusted.c_str());
-            } else {
-              std::array<char, MaxDebugBufferLength + 2u> buffer;
-
-              for (size_t i = 0; i < adjusted.size(); i += MaxDebugBufferLength) {
-                size_t size = std::min(adjusted.size() - i, MaxDebugBufferLength);
-
-                std::strncpy(buffer.data(), &adjusted[i], size);
-                if (buffer[size - 1u] != '\n')
-                  buffer[size++] = '\n';
-
-                buffer[size] = '\0';
-                m_wineLogOutput(buffer.data());
-              }
+        if (m_wineLogOutput) {
+          // __wine_dbg_output tries to buffer lines up to 1020 characters
+          // including null terminator, and will cause a hang if we submit
+          // anything longer than that even in consecutive calls. Work
+          // around this by splitting long lines into multiple lines.
+          constexpr size_t MaxDebugBufferLength = 1018;
+
+          if (adjusted.size() <= MaxDebugBufferLength) {
+            m_wineLogOutput(adjusted.c_str());
+          } else {
+            std::array<char, MaxDebugBufferLength + 2u> buffer;
+
+            for (size_t i = 0; i < adjusted.size(); i += MaxDebugBufferLength) {
+              size_t size = std::min(adjusted.size() - i, MaxDebugBufferLength);
+
+              std::strncpy(buffer.data(), &adjusted[i], size);
+              if (buffer[size - 1u] != '\n')
+                buffer[size++] = '\n';
+
+              buffer[size] = '\0';
+              m_wineLogOutput(buffer.data());
             }
           }
+        }
 
-          // Don't log anything to stderr if we're not on wine. Usually games are
-          // compiled as gui apps anyway, and emitting anything to the standard
-          // output streams can crash certain games.
+        // Don't log anything to stderr if we're not on wine. Usually games are
+        // compiled as gui apps anyway, and emitting anything to the standard
+        // output streams can crash certain games.
 #else
-          // For native builds, logging to stderr should be fine.
-          std::cerr << adjusted;
+        // For native builds, logging to stderr should be fine.
+        std::cerr << adjusted;
 #endif
-        }
+      }
+
+      if (m_fileStream) {
+        m_fileStream << adjusted;
+        m_fileStream.flush();
+      }
+    }
+  }
 
-        if (m_fileStream) {
-          m_fileStream << adjusted;
-          m_fileStream.flush();
+
+  bool Logger::enqueueMsg(LogLevel level, const std::string& message) {
+    uint64_t pos = m_queueWrite.load(std::memory_order_relaxed);
+
+    while (true) {
+      auto& entry = (*m_queue)[pos % QueueSize];
+      uint64_t seq = entry.sequence.load(std::memory_order_acquire);
+
+      if (seq == pos) {
+        if (m_queueWrite.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed)) {
+          entry.level = level;
+          entry.message = message;
+          entry.sequence.store(pos + 1u, std::memory_order_release);
+          return true;
         }
+      } else if (seq < pos) {
+        // Slot still holds a message from the
+        // previous cycle, i.e. the queue is full
+        return false;
+      } else {
+        pos = m_queueWrite.load(std::memory_order_relaxed);
       }
     }
   }
+
+
+  void Logger::drainQueue() {
+    while (true) {
+      auto& entry = (*m_queue)[m_queueRead % QueueSize];
+
+      if (entry.sequence.load(std::memory_order_acquire) != m_queueRead + 1u)
+        break;
+
+      LogLevel level = entry.level;
+      std::string message = std::move(entry.message);
+
+      entry.sequence.store(m_queueRead + QueueSize, std::memory_order_release);
+      m_queueRead += 1u;
+
+      // Rate-limit identical messages within each interval
+      // and report the number of suppressed messages later
+      auto& repeat = m_repeats[message];
+      repeat.level = level;
+
+      if (++repeat.count > MaxRepeatsPerInterval)
+        repeat.suppressed += 1u;
+      else
+        writeMsg(level, message);
+    }
+
+    uint64_t dropped = m_queueDropped.exchange(0u, std::memory_order_relaxed);
+
+    if (dropped)
+      writeMsg(LogLevel::Warn, str::format("Log queue full, dropped ", dropped, " messages"));
+
+    flushRepeats(false);
+  }
+
+
+  void Logger::flushRepeats(bool force) {
+    auto now = high_resolution_clock::now();
+
+    if (!force && now - m_repeatInterval < std::chrono::seconds(1))
+      return;
+
+    m_repeatInterval = now;
+
+    for (const auto& repeat : m_repeats) {
+      if (repeat.second.suppressed) {
+        writeMsg(repeat.second.level, str::format("Last message repeated ",
+          repeat.second.suppressed, " more times: ", repeat.first));
+      }
+    }
+
+    m_repeats.clear();
+  }
+
+
+  void Logger::startThread() {
+    std::lock_guard lock(m_mutex);
+
+    if (m_threadStarted.load(std::memory_order_relaxed))
+      return;
+
+    m_repeatInterval = high_resolution_clock::now();
+    m_thread = dxvk::thread([this] { runThread(); });
+
+    installCrashHandlers();
+
+    m_threadStarted.store(true, std::memory_order_release);
+  }
+
+
+  void Logger::runThread() {
+    env::setThreadName("dxvk-log");
+
+    std::unique_lock lock(m_mutex);
+
+    while (!m_stopped) {
+      drainQueue();
+
+      // Producers signal without holding the lock, so
+      // use a timeout in case we miss a notification
+      m_cond.wait_for(lock, std::chrono::milliseconds(10), [this] {
+        auto& entry = (*m_queue)[m_queueRead % QueueSize];
+        return m_stopped || entry.sequence.load(std::memory_order_acquire) == m_queueRead + 1u;
+      });
+    }
+
+    drainQueue();
+    flushRepeats(true);
+  }
+
+
+  void Logger::installCrashHandlers() {
+    // Queued messages are often the ones that explain a crash,
+    // so try to write them out before the process goes away.
+    // Previous handlers are chained so that applications and
+    // other modules can still handle exceptions and signals.
+#ifdef _WIN32
+    g_prevExceptionFilter = SetUnhandledExceptionFilter(&handleException);
+#else
+    for (size_t i = 0; i < g_crashSignals.size(); i++) {
+      struct sigaction action = { };
+      action.sa_sigaction = &handleSignal;
+      action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+      sigemptyset(&action.sa_mask);
+
+      sigaction(g_crashSignals[i], &action, &g_prevSignalActions[i]);
+    }
+
+    g_prevTerminateHandler = std::set_terminate(&handleTerminate);
+#endif
+
+    m_crashHandlers = true;
+  }
+
+
+  void Logger::removeCrashHandlers() {
+    if (!std::exchange(m_crashHandlers, false))
+      return;
+
+    // Only restore previous handlers if ours are still installed,
+    // we must not leave dangling pointers into this module behind.
+#ifdef _WIN32
+    auto filter = SetUnhandledExceptionFilter(g_prevExceptionFilter);
+
+    if (filter != &handleException)
+      SetUnhandledExceptionFilter(filter);
+#else
+    for (size_t i = 0; i < g_crashSignals.size(); i++) {
+      struct sigaction action = { };
+      sigaction(g_crashSignals[i], nullptr, &action);
+
+      if ((action.sa_flags & SA_SIGINFO) && action.sa_sigaction == &handleSignal)
+        sigaction(g_crashSignals[i], &g_prevSignalActions[i], nullptr);
+    }
+
+    if (std::get_terminate() == &handleTerminate)
+      std::set_terminate(g_prevTerminateHandler);
+#endif
+  }
+
+
+  void Logger::flushOnCrash() {
+    // The crashing thread may already hold the lock, or it may
+    // be held by a thread that will never run again, so only
+    // write out pending messages if we can do so without waiting.
+    std::unique_lock lock(s_instance.m_mutex, std::try_to_lock);
+
+    if (lock) {
+      s_instance.drainQueue();
+      s_instance.flushRepeats(true);
+    }
+  }
+
+
+#ifdef _WIN32
+  long __stdcall Logger::handleException(
+          struct _EXCEPTION_POINTERS* info) {
+    flushOnCrash();
+
+    return g_prevExceptionFilter
+      ? g_prevExceptionFilter(info)
+      : EXCEPTION_CONTINUE_SEARCH;
+  }
+#else
+  void Logger::handleSignal(
+          int                   signal,
+          siginfo_t*            info,
+          void*                 context) {
+    size_t index = 0;
+
+    while (g_crashSignals[index] != signal)
+      index++;
+
+    const auto& prev = g_prevSignalActions[index];
+
+    // Some runtimes handle signals such as SIGSEGV themselves and
+    // recover from them, so only flush if the signal would otherwise
+    // terminate the process. Writing the log is not async-signal-safe,
+    // which is acceptable since the process is going down anyway.
+    if (prev.sa_flags & SA_SIGINFO) {
+      prev.sa_sigaction(signal, info, context);
+    } else if (prev.sa_handler != SIG_DFL && prev.sa_handler != SIG_IGN) {
+      prev.sa_handler(signal);
+    } else {
+      flushOnCrash();
+
+      // Restore the default action and re-raise the signal,
+      // it will be delivered as soon as this handler returns
+      sigaction(signal, &prev, nullptr);
+      raise(signal);
+    }
+  }
+
+
+  void Logger::handleTerminate() {
+    flushOnCrash();
+
+    if (g_prevTerminateHandler)
+      g_prevTerminateHandler();
+
+    std::abort();
+  }
+#endif
   
   
-  std::string Logger::getFileName(const std::string& base) {
+  std::string Logger::getFilePath(const std::string& base) {
     std::string path = env::getEnvVar("DXVK_LOG_PATH");
     
     if (path == "none")
@@ -129,7 +428,7 @@ namespace dxvk {
 
 #ifdef _WIN32
     // Don't create a log file if we're writing to wine's console output
-    if (path.empty() && m_wineLogOutput)
+    if (path.empty() && getWineLogOutput())
       return std::string();
 #endif
 
@@ -161,5 +460,17 @@ namespace dxvk {
     
     return LogLevel::Info;
   }
+
+
+#ifdef _WIN32
+  PFN_wineLogOutput Logger::getWineLogOutput() {
+    HMODULE ntdll = GetModuleHandleA("ntdll.dll");
+
+    if (!ntdll)
+      return nullptr;
+
+    return reinterpret_cast<PFN_wineLogOutput>(GetProcAddress(ntdll, "__wine_dbg_output"));
+  }
+#endif
   
 }
@@ -1,11 +1,20 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <csignal>
+#endif
 
 #include "../thread.h"
+#include "../util_math.h"
+#include "../util_time.h"
 
 namespace dxvk {
   
@@ -27,9 +36,20 @@ namespace dxvk {
    * 
    * Logger for one DLL. Creates a text file and
    * writes all log messages to that file.
+   *
+   * If \c DXVK_LOG_ASYNC is set, messages below the error
+   * level are pushed to a bounded lock-free queue instead
+   * and written by a background thread, so that logging
+   * threads never wait for file I/O. Repeated messages are
+   * rate-limited, and messages get dropped if the queue is
+   * full. Errors are always written synchronously, after
+   * writing out all pending messages. Pending messages are
+   * also written out if the process crashes, on a best-effort
+   * basis.
    */
   class Logger {
-    
+    constexpr static uint32_t QueueSize = 1024u;
+    constexpr static uint32_t MaxRepeatsPerInterval = 8u;
   public:
     
     Logger(const std::string& file_name);
@@ -45,29 +65,113 @@ namespace dxvk {
     static LogLevel logLevel() {
       return s_instance.m_minLevel;
     }
+
+    /**
+     * \brief Writes out all pending messages
+     *
+     * Only has an effect in asynchronous mode. Should be
+     * called on fatal errors so that no messages get lost
+     * if the process gets terminated afterwards.
+     */
+    static void flush();
+
+    /**
+     * \brief Computes path of a log file
+     *
+     * Respects \c DXVK_LOG_PATH in the same way as the
+     * main log file does, and prefixes the file name with
+     * the executable name.
+     * \param [in] base Base file name
+     * \returns File path, or an empty string if no
+     *    log files should be written.
+     */
+    static std::string getFilePath(
+      const std::string& base);
     
   private:
+
+    struct QueueEntry {
+      std::atomic<uint64_t> sequence = { 0u };
+      LogLevel              level    = LogLevel::Info;
+      std::string           message;
+    };
+
+    struct RepeatInfo {
+      LogLevel              level      = LogLevel::Info;
+      uint32_t              count      = 0u;
+      uint32_t              suppressed = 0u;
+    };
     
     static Logger     s_instance;
     
     const LogLevel    m_minLevel;
     const std::string m_fileName;
+    const bool        m_async;
     
     dxvk::mutex       m_mutex;
     std::ofstream     m_fileStream;
 
     bool              m_initialized = false;
+    bool              m_crashHandlers = false;
 #ifdef _WIN32
     PFN_wineLogOutput m_wineLogOutput = nullptr;
 #endif
 
+    std::unique_ptr<std::array<QueueEntry, QueueSize>> m_queue;
+
+    alignas(CACHE_LINE_SIZE)
+    std::atomic<uint64_t> m_queueWrite    = { 0u };
+    std::atomic<uint64_t> m_queueDropped  = { 0u };
+    std::atomic<bool>     m_threadStarted = { false };
+
+    alignas(CACHE_LINE_SIZE)
+    uint64_t          m_queueRead = 0u;
+    bool              m_stopped   = false;
+
+    dxvk::condition_variable m_cond;
+    dxvk::thread      m_thread;
+
+    std::unordered_map<std::string, RepeatInfo> m_repeats;
+    high_resolution_clock::time_point m_repeatInterval = { };
+
     void emitMsg(LogLevel level, const std::string& message);
-    
-    std::string getFileName(
-      const std::string& base);
+
+    void writeMsg(LogLevel level, const std::string& message);
+
+    bool enqueueMsg(LogLevel level, const std::string& message);
+
+    void drainQueue();
+
+    void flushRepeats(bool force);
+
+    void startThread();
+
+    void runThread();
+
+    void installCrashHandlers();
+
+    void removeCrashHandlers();
+
+    static void flushOnCrash();
+
+#ifdef _WIN32
+    static long __stdcall handleException(
+            struct _EXCEPTION_POINTERS* info);
+#else
+    static void handleSignal(
+            int                   signal,
+            siginfo_t*            info,
+            void*                 context);
+
+    static void handleTerminate();
+#endif
 
     static LogLevel getMinLogLevel();
 
+#ifdef _WIN32
+    static PFN_wineLogOutput getWineLogOutput();
+#endif
+
   };
   
 }
@@ -9,6 +9,24 @@
 
 namespace dxvk::sync {
 
+  /**
+   * \brief Pauses execution for a short time
+   *
+   * Hints to the CPU that the calling
+   * thread is in a busy-wait loop.
+   */
+  inline void pause() {
+    #if defined(DXVK_ARCH_X86)
+    _mm_pause();
+    #elif defined(DXVK_ARCH_ARM64)
+    __asm__ __volatile__ ("yield");
+    #else
+    /* Do nothing (busy-loop). Please add more #elif above here if
+     * your CPU architecture has a suitable pause/yield instruction */
+    #endif
+  }
+
+
   /**
    * \brief Generic spin function
    *
@@ -21,14 +39,8 @@ namespace dxvk::sync {
   void spin(uint32_t spinCount, const Fn& fn) {
     while (unlikely(!fn())) {
       for (uint32_t i = 1; i < spinCount; i++) {
-        #if defined(DXVK_ARCH_X86)
-        _mm_pause();
-        #elif defined(DXVK_ARCH_ARM64)
-        __asm__ __volatile__ ("yield");
-        #else
-        /* Do nothing (busy-loop). Please add more #elif above here if
-         * your CPU architecture has a suitable pause/yield instruction */
-        #endif
+        pause();
+
         if (fn())
           return;
       }
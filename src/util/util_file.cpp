@@ -1,5 +1,13 @@
 #include <fstream>
 
+#ifndef _WIN32
+#include <cerrno>
+#include <limits>
+
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include "./com/com_include.h"
 
 #include "./log/log.h"
@@ -98,6 +106,18 @@ namespace dxvk::util {
       return FlushFileBuffers(m_file);
     }
 
+    bool lock(bool exclusive) {
+      OVERLAPPED overlapped = { };
+      DWORD flags = exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0u;
+
+      return LockFileEx(m_file, flags, 0u, MAXDWORD, MAXDWORD, &overlapped);
+    }
+
+    bool unlock() {
+      OVERLAPPED overlapped = { };
+      return UnlockFileEx(m_file, 0u, MAXDWORD, MAXDWORD, &overlapped);
+    }
+
   private:
 
     FileFlags m_flags = { };
@@ -151,10 +171,14 @@ namespace dxvk::util {
 #else
 
   class StlFile : public FileIface {
-
+    // Byte range locked by every process that has the file open
+    // for writing, used to emulate exclusive share modes. This is
+    // past the range covered by advisory locks and file data.
+    constexpr static off_t UseLockOffset = std::numeric_limits<off_t>::max();
   public:
 
-    StlFile(const std::string& path, FileFlags flags) {
+    StlFile(const std::string& path, FileFlags flags)
+    : m_flags(flags), m_path(path) {
       std::ios_base::openmode mode = std::ios_base::binary;
 
       if (flags.test(FileFlag::AllowRead))
@@ -166,11 +190,21 @@ namespace dxvk::util {
       if (flags.test(FileFlag::Truncate))
         mode |= std::ios_base::trunc;
 
+      // Take the use lock before opening the file stream so that we
+      // never truncate a file that another process is still using.
+      if (flags.test(FileFlag::AllowWrite) || flags.test(FileFlag::Exclusive)) {
+        bool create = (mode & std::ios_base::trunc) || !(mode & std::ios_base::in);
+
+        if (!lockUse(flags.test(FileFlag::Exclusive), create))
+          return;
+      }
+
       m_file.open(path, mode);
     }
 
     ~StlFile() {
-
+      if (m_lockFd >= 0)
+        ::close(m_lockFd);
     }
 
     bool read(size_t offset, size_t size, void* data) {
@@ -229,11 +263,82 @@ namespace dxvk::util {
       return true;
     }
 
+    bool lock(bool exclusive) {
+      // fstream does not expose the underlying file descriptor, so
+      // lock the file through a separate descriptor. Note that POSIX
+      // record locks are owned by the process, not the descriptor.
+      if (m_lockFd < 0 && !openLockFd(false))
+        return false;
+
+      struct flock lock = { };
+      lock.l_type = exclusive ? F_WRLCK : F_RDLCK;
+      lock.l_whence = SEEK_SET;
+      lock.l_start = 0;
+      lock.l_len = UseLockOffset;
+
+      int result;
+
+      do {
+        result = ::fcntl(m_lockFd, F_SETLKW, &lock);
+      } while (result && errno == EINTR);
+
+      return !result;
+    }
+
+    bool unlock() {
+      if (m_lockFd < 0)
+        return false;
+
+      struct flock lock = { };
+      lock.l_type = F_UNLCK;
+      lock.l_whence = SEEK_SET;
+      lock.l_start = 0;
+      lock.l_len = UseLockOffset;
+
+      return !::fcntl(m_lockFd, F_SETLK, &lock);
+    }
+
   private:
 
     FileFlags     m_flags = { };
     std::fstream  m_file;
 
+    std::string   m_path;
+    int           m_lockFd = -1;
+
+    bool openLockFd(bool create) {
+      int flags = O_CLOEXEC;
+
+      if (m_flags.test(FileFlag::AllowWrite) || m_flags.test(FileFlag::Exclusive))
+        flags |= O_RDWR;
+      else
+        flags |= O_RDONLY;
+
+      if (create)
+        flags |= O_CREAT;
+
+      m_lockFd = ::open(m_path.c_str(), flags, 0644);
+      return m_lockFd >= 0;
+    }
+
+    bool lockUse(bool exclusive, bool create) {
+      if (!openLockFd(create))
+        return false;
+
+      struct flock lock = { };
+      lock.l_type = exclusive ? F_WRLCK : F_RDLCK;
+      lock.l_whence = SEEK_SET;
+      lock.l_start = UseLockOffset;
+      lock.l_len = 1;
+
+      if (!::fcntl(m_lockFd, F_SETLK, &lock))
+        return true;
+
+      // Fail if the file is in use by another process. If locking is
+      // not supported at all, we cannot guarantee exclusive access.
+      return !exclusive && errno != EACCES && errno != EAGAIN;
+    }
+
   };
 
   using FileImpl = StlFile;
@@ -300,6 +405,14 @@ namespace dxvk::util {
     return m_impl && m_impl->flush();
   }
 
+  bool File::lock(bool exclusive) {
+    return m_impl && m_impl->lock(exclusive);
+  }
+
+  bool File::unlock() {
+    return m_impl && m_impl->unlock();
+  }
+
   File::operator bool () const {
     return m_impl && m_impl->status();
   }
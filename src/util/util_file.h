@@ -13,6 +13,10 @@ namespace dxvk::util {
 
   /**
    * \brief File flags
+   *
+   * \c Exclusive opens fail if another process has the file
+   * open for writing, and prevent other processes from opening
+   * the file for writing until it is closed.
    */
   enum class FileFlag : uint32_t {
     AllowRead       = 0,
@@ -45,6 +49,10 @@ namespace dxvk::util {
 
     virtual bool flush() = 0;
 
+    virtual bool lock(bool exclusive) = 0;
+
+    virtual bool unlock() = 0;
+
     force_inline void incRef() {
       m_refCount.fetch_add(1u);
     }
@@ -94,6 +102,23 @@ namespace dxvk::util {
 
     bool flush();
 
+    /**
+     * \brief Acquires advisory lock on the entire file
+     *
+     * Blocks until the lock can be acquired. Shared locks can be
+     * held by multiple processes at once, exclusive locks cannot.
+     * \param [in] exclusive Whether to acquire an exclusive lock
+     * \returns \c true on success, \c false if the lock could not
+     *    be acquired or locking is not supported on the platform.
+     */
+    bool lock(bool exclusive);
+
+    /**
+     * \brief Releases lock previously acquired with \c lock
+     * \returns \c true on success
+     */
+    bool unlock();
+
     explicit operator bool () const;
 
   private:
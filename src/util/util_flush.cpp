@@ -4,8 +4,8 @@
 
 namespace dxvk {
 
-  GpuFlushTracker::GpuFlushTracker(GpuFlushType maxType)
-  : m_maxType(maxType) {
+  GpuFlushTracker::GpuFlushTracker(GpuFlushType maxType, GpuFlushMode mode)
+  : m_mode(mode), m_maxType(maxType) {
 
   }
 
@@ -29,7 +29,7 @@ namespace dxvk {
     // submission requests anyway, since we should never submit enough to time
     // out with the chunk-based heuristic.
     if (flushType > m_maxType)
-      return estimatedCost >= GpuCostEstimate::MaxCostPerSubmission;
+      return estimatedCost >= scaleThreshold(GpuCostEstimate::MaxCostPerSubmission);
 
     // Take any earlier missed flush with a stronger hint into account, so
     // that we still flush those as soon as possible. Ignore synchronization
@@ -54,7 +54,7 @@ namespace dxvk {
       case GpuFlushType::ImplicitWeakHint: {
         // Aim for a higher number of chunks per submission with
         // a weak hint in order to avoid submitting too often.
-        if (chunkCount < 2 * minChunkCount)
+        if (chunkCount < scaleThreshold(2 * minChunkCount))
           return false;
 
         // Actual heuristic is shared with synchronization commands
@@ -71,7 +71,8 @@ namespace dxvk {
         // Use the number of pending submissions to decide whether to flush. Other
         // than ignoring the minimum chunk count condition, we should treat this
         // the same as weak hints to avoid unnecessary synchronization.
-        uint32_t threshold = std::min(maxChunkCount, pendingSubmissions * minChunkCount);
+        uint32_t threshold = std::min(scaleThreshold(maxChunkCount),
+          pendingSubmissions * scaleThreshold(minChunkCount));
         return chunkCount >= threshold;
       }
 
@@ -93,4 +94,43 @@ namespace dxvk {
     m_lastFlushSubmissionId = submissionId;
   }
 
+
+  void GpuFlushTracker::notifyFeedback(
+    const GpuFlushFeedback&     feedback) {
+    auto now = high_resolution_clock::now();
+
+    if (m_lastFeedbackTime == high_resolution_clock::time_point()) {
+      m_lastFeedback = feedback;
+      m_lastFeedbackTime = now;
+      return;
+    }
+
+    // Flushes can happen in quick succession, evaluate feedback
+    // over a longer period of time in order to reduce noise.
+    uint64_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - m_lastFeedbackTime).count();
+
+    if (elapsed < FeedbackIntervalUs)
+      return;
+
+    uint64_t idleTicks = feedback.gpuIdleTicks - m_lastFeedback.gpuIdleTicks;
+    uint64_t submissionCount = feedback.submissionCount - m_lastFeedback.submissionCount;
+    uint64_t submissionTicks = feedback.submissionTicks - m_lastFeedback.submissionTicks;
+
+    m_lastFeedback = feedback;
+    m_lastFeedbackTime = now;
+
+    float idleRatio = float(idleTicks) / float(elapsed);
+    uint64_t avgSubmissionTime = submissionCount ? submissionTicks / submissionCount : 0u;
+
+    if (idleRatio > MaxIdleRatio || avgSubmissionTime > MaxSubmissionTimeUs) {
+      // Either the GPU is starved or submissions take long enough to
+      // noticeably delay synchronization, so submit work sooner.
+      m_scale = std::max(MinScale, m_scale - (m_scale >> 2u));
+    } else if (submissionCount && avgSubmissionTime < MinSubmissionTimeUs) {
+      // GPU is fully busy with lots of small submissions,
+      // batch more work per submission to reduce overhead.
+      m_scale = std::min(MaxScale, m_scale + (m_scale >> 3u));
+    }
+  }
+
 }
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <vector>
 
+#include "util_time.h"
+
 namespace dxvk {
 
   /**
@@ -54,6 +57,34 @@ namespace dxvk {
   };
 
 
+  /**
+   * \brief GPU flush mode
+   */
+  enum class GpuFlushMode : uint32_t {
+    /** Use fixed chunk count and cost thresholds */
+    Static                  = 0,
+    /** Scale thresholds based on measured GPU idle
+     *  time and GPU execution time per submission */
+    Adaptive                = 1,
+  };
+
+
+  /**
+   * \brief GPU execution feedback
+   *
+   * Monotonically increasing counters provided by the
+   * submission queue, used by the adaptive flush mode.
+   */
+  struct GpuFlushFeedback {
+    /** Accumulated GPU idle time, in us */
+    uint64_t gpuIdleTicks     = 0u;
+    /** Number of completed submissions */
+    uint64_t submissionCount  = 0u;
+    /** Accumulated GPU execution time of completed submissions, in us */
+    uint64_t submissionTicks  = 0u;
+  };
+
+
   /**
    * \brief GPU flush tracker
    *
@@ -64,7 +95,15 @@ namespace dxvk {
 
   public:
 
-    GpuFlushTracker(GpuFlushType maxAllowed);
+    GpuFlushTracker(GpuFlushType maxAllowed, GpuFlushMode mode = GpuFlushMode::Static);
+
+    /**
+     * \brief Checks whether GPU feedback is used
+     * \returns \c true if \c notifyFeedback should be called
+     */
+    bool needsFeedback() const {
+      return m_mode == GpuFlushMode::Adaptive;
+    }
 
     /**
      * \brief Queries type of last missed submission request
@@ -106,14 +145,50 @@ namespace dxvk {
             uint64_t              chunkId,
             uint64_t              submissionId);
 
+    /**
+     * \brief Updates adaptive thresholds from GPU feedback
+     *
+     * Should be called on every context flush when using the
+     * adaptive flush mode. If the GPU went idle, thresholds are
+     * lowered so that work gets submitted sooner. If submissions
+     * take long to execute, they are lowered in order to bound
+     * latency. If the GPU is busy and submissions are small, they
+     * are raised in order to reduce submission overhead.
+     * \param [in] feedback Current GPU feedback counters
+     */
+    void notifyFeedback(
+      const GpuFlushFeedback&     feedback);
+
   private:
 
+    /** Minimum interval over which feedback is evaluated, in us */
+    static constexpr uint64_t FeedbackIntervalUs      = 4'000u;
+    /** GPU idle ratio above which thresholds get lowered */
+    static constexpr float    MaxIdleRatio            = 0.02f;
+    /** Average submission time above which thresholds get lowered */
+    static constexpr uint64_t MaxSubmissionTimeUs     = 8'000u;
+    /** Average submission time below which thresholds get raised */
+    static constexpr uint64_t MinSubmissionTimeUs     = 1'000u;
+    /** Threshold scale limits, in 1/256 units */
+    static constexpr uint32_t MinScale                = 64u;
+    static constexpr uint32_t MaxScale                = 1024u;
+
+    GpuFlushMode  m_mode                  = GpuFlushMode::Static;
     GpuFlushType  m_maxType               = GpuFlushType::ImplicitWeakHint;
     GpuFlushType  m_lastMissedType        = GpuFlushType::None;
 
     uint64_t      m_lastFlushChunkId      = 0ull;
     uint64_t      m_lastFlushSubmissionId = 0ull;
 
+    uint32_t      m_scale                 = 256u;
+
+    GpuFlushFeedback                  m_lastFeedback = { };
+    high_resolution_clock::time_point m_lastFeedbackTime = { };
+
+    uint32_t scaleThreshold(uint32_t threshold) const {
+      return std::max(1u, (threshold * m_scale) >> 8u);
+    }
+
   };
 
 }
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <thread>
 
 #include "thread.h"
@@ -46,6 +47,22 @@ namespace dxvk {
 
 
   void FpsLimiter::delay() {
+    delayFrame(TimePoint());
+  }
+
+
+  void FpsLimiter::delay(TimePoint presentTime) {
+    delayFrame(presentTime);
+  }
+
+
+  FpsLimiterStats FpsLimiter::getStats() {
+    std::lock_guard lock(m_statsLock);
+    return std::exchange(m_stats, FpsLimiterStats());
+  }
+
+
+  void FpsLimiter::delayFrame(TimePoint presentTime) {
     std::unique_lock<dxvk::mutex> lock(m_mutex);
     auto interval = m_targetInterval;
     auto latency = m_maxLatency;
@@ -68,12 +85,79 @@ namespace dxvk {
     // that can be written by setTargetFrameRate
     lock.unlock();
 
+    auto nextFrame = computeNextFrame(interval, t1, presentTime);
+
     if (t1 < m_nextFrame)
       Sleep::sleepUntil(t1, m_nextFrame);
 
-    m_nextFrame = (t1 < m_nextFrame + interval)
-      ? m_nextFrame + interval
-      : t1 + interval;
+    m_nextFrame = nextFrame;
+  }
+
+
+  FpsLimiter::TimePoint FpsLimiter::computeNextFrame(TimerDuration interval, TimePoint now, TimePoint presentTime) {
+    // If we are not actually limiting the frame rate, or if we have no
+    // information about when frames get displayed, use a fixed cadence.
+    bool canLock = presentTime != TimePoint() && now < m_nextFrame;
+
+    if (!canLock || m_pacingInterval != interval) {
+      m_pacingInterval = interval;
+      m_pacingPeriod = interval;
+      m_pacingLocked = false;
+
+      std::lock_guard lock(m_statsLock);
+      m_stats.frameInterval = std::chrono::duration_cast<std::chrono::microseconds>(interval);
+
+      return (now < m_nextFrame + interval)
+        ? m_nextFrame + interval
+        : now + interval;
+    }
+
+    // The time between a frame being presented and us releasing the next
+    // frame stays constant if our cadence matches the display's. Any change
+    // in that slack from one frame to the next is the difference between
+    // our frame period and the display's, and the difference to the slack
+    // we locked on to is the phase error.
+    TimerDuration slack = m_nextFrame - presentTime;
+
+    if (!m_pacingLocked) {
+      m_pacingSlack = slack;
+      m_pacingTarget = slack;
+      m_pacingLocked = true;
+      return m_nextFrame + m_pacingPeriod;
+    }
+
+    TimerDuration drift = slack - m_pacingSlack;
+    m_pacingSlack = slack;
+
+    // Large jumps are caused by missed refresh cycles or
+    // hitches rather than drift, re-acquire phase instead.
+    if (drift > interval / 4 || drift < -interval / 4) {
+      m_pacingTarget = slack;
+      return m_nextFrame + m_pacingPeriod;
+    }
+
+    // Adjust frame period towards the display cadence, but only
+    // by a small amount so that the effective frame rate remains
+    // close to what the user asked for.
+    TimerDuration maxCorrection = interval / 64;
+
+    m_pacingPeriod -= drift / 16;
+    m_pacingPeriod = std::clamp(m_pacingPeriod,
+      interval - maxCorrection, interval + maxCorrection);
+
+    TimerDuration phaseError = slack - m_pacingTarget;
+
+    { std::lock_guard lock(m_statsLock);
+      auto error = std::chrono::duration_cast<std::chrono::microseconds>(
+        phaseError < TimerDuration::zero() ? -phaseError : phaseError);
+
+      m_stats.lockedFrames += 1u;
+      m_stats.phaseErrorSum += error;
+      m_stats.phaseErrorMax = std::max(m_stats.phaseErrorMax, error);
+      m_stats.frameInterval = std::chrono::duration_cast<std::chrono::microseconds>(m_pacingPeriod);
+    }
+
+    return m_nextFrame + m_pacingPeriod - phaseError / 8;
   }
 
 
@@ -6,8 +6,26 @@
 #include "thread.h"
 #include "util_time.h"
 
+#include "./sync/sync_spinlock.h"
+
 namespace dxvk {
-  
+
+  /**
+   * \brief Frame pacing statistics
+   *
+   * Accumulated since the last time statistics were queried.
+   */
+  struct FpsLimiterStats {
+    /// Number of frames paced using present feedback
+    uint32_t lockedFrames = 0u;
+    /// Sum of absolute phase errors over all locked frames
+    std::chrono::microseconds phaseErrorSum = std::chrono::microseconds(0u);
+    /// Largest absolute phase error of any locked frame
+    std::chrono::microseconds phaseErrorMax = std::chrono::microseconds(0u);
+    /// Current frame interval, including period corrections
+    std::chrono::microseconds frameInterval = std::chrono::microseconds(0u);
+  };
+
   /**
    * \brief Frame rate limiter
    *
@@ -40,6 +58,23 @@ namespace dxvk {
      */
     void delay();
 
+    /**
+     * \brief Stalls calling thread using present feedback
+     *
+     * Like \ref delay, but also uses the time at which the previous
+     * frame was actually presented in order to lock the limiter's
+     * frame cadence to the display's. Must be called right after
+     * the previous frame has been presented.
+     * \param [in] presentTime Time when the frame was presented
+     */
+    void delay(dxvk::high_resolution_clock::time_point presentTime);
+
+    /**
+     * \brief Queries and resets frame pacing statistics
+     * \returns Statistics since the previous call
+     */
+    FpsLimiterStats getStats();
+
   private:
 
     using TimePoint = dxvk::high_resolution_clock::time_point;
@@ -57,6 +92,20 @@ namespace dxvk {
 
     bool            m_warningShown    = false;
 
+    // Pacing loop state, only accessed by the thread calling delay
+    TimerDuration   m_pacingInterval  = TimerDuration::zero();
+    TimerDuration   m_pacingPeriod    = TimerDuration::zero();
+    TimerDuration   m_pacingSlack     = TimerDuration::zero();
+    TimerDuration   m_pacingTarget    = TimerDuration::zero();
+    bool            m_pacingLocked    = false;
+
+    sync::Spinlock  m_statsLock;
+    FpsLimiterStats m_stats = { };
+
+    void delayFrame(TimePoint presentTime);
+
+    TimePoint computeNextFrame(TimerDuration interval, TimePoint now, TimePoint presentTime);
+
     bool testRefreshHeuristic(TimerDuration interval, TimePoint now, uint32_t maxLatency);
 
   };
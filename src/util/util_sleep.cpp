@@ -1,8 +1,14 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include "util_env.h"
 #include "util_sleep.h"
 #include "util_string.h"
 
 #include "./log/log.h"
 
+#include "./sync/sync_spinlock.h"
+
 using namespace std::chrono_literals;
 
 namespace dxvk {
@@ -29,6 +35,15 @@ namespace dxvk {
     initializePlatformSpecifics();
     m_sleepThreshold = 4 * m_sleepGranularity;
 
+    std::string spinBudget = env::getEnvVar("DXVK_SLEEP_SPIN_BUDGET");
+
+    if (!spinBudget.empty()) {
+      int64_t us = std::max<int64_t>(std::strtoll(spinBudget.c_str(), nullptr, 10), 0);
+
+      m_spinBudget = std::chrono::duration_cast<TimerDuration>(std::chrono::microseconds(us));
+      Logger::info(str::format("Limiting sleep spin time to ", us, " us"));
+    }
+
     m_initialized.store(true);
   }
 
@@ -78,10 +93,7 @@ namespace dxvk {
 
     // Busy-wait for the last couple of milliseconds since sleeping
     // on Windows is highly inaccurate and inconsistent.
-    TimerDuration sleepThreshold = m_sleepThreshold;
-
-    if (m_sleepGranularity != TimerDuration::zero())
-      sleepThreshold += duration / 6;
+    TimerDuration sleepThreshold = computeSpinThreshold(duration);
 
     TimerDuration remaining = duration;
     TimePoint t1 = t0;
@@ -92,12 +104,18 @@ namespace dxvk {
       systemSleep(sleepDuration);
 
       t1 = dxvk::high_resolution_clock::now();
-      remaining -= std::chrono::duration_cast<TimerDuration>(t1 - t0);
+
+      TimerDuration elapsed = std::chrono::duration_cast<TimerDuration>(t1 - t0);
+      recordOvershoot(elapsed - sleepDuration);
+
+      remaining -= elapsed;
       t0 = t1;
     }
 
     // Busy-wait until we have slept long enough
     while (remaining > TimerDuration::zero()) {
+      sync::pause();
+
       t1 = dxvk::high_resolution_clock::now();
       remaining -= std::chrono::duration_cast<TimerDuration>(t1 - t0);
       t0 = t1;
@@ -122,4 +140,46 @@ namespace dxvk {
 #endif
   }
 
+
+
+  Sleep::TimerDuration Sleep::computeSpinThreshold(TimerDuration duration) {
+    std::lock_guard lock(m_mutex);
+
+    TimerDuration threshold = m_overshootEstimate;
+
+    // Until we have gathered enough samples, fall back to a
+    // conservative estimate based on the timer granularity.
+    if (m_overshootSampleCount < OvershootMinSamples) {
+      threshold = m_sleepThreshold;
+
+      if (m_sleepGranularity != TimerDuration::zero())
+        threshold += duration / 6;
+    }
+
+    return std::min(threshold, m_spinBudget);
+  }
+
+
+  void Sleep::recordOvershoot(TimerDuration overshoot) {
+    std::lock_guard lock(m_mutex);
+
+    overshoot = std::max(overshoot, TimerDuration::zero());
+    m_overshootSamples[m_overshootSampleCount % OvershootSampleCount] = overshoot;
+
+    uint32_t sampleCount = std::min(++m_overshootSampleCount, OvershootSampleCount);
+
+    if (sampleCount < OvershootMinSamples)
+      return;
+
+    // Use the 95th percentile of recent overshoot samples, plus some
+    // margin, so that we rarely wake up too late while keeping the
+    // amount of time spent spinning low.
+    std::array<TimerDuration, OvershootSampleCount> samples = m_overshootSamples;
+
+    uint32_t index = (sampleCount * 95u) / 100u;
+    std::nth_element(samples.begin(), samples.begin() + index, samples.begin() + sampleCount);
+
+    m_overshootEstimate = samples[index] + samples[index] / 4;
+  }
+
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+
 #include "thread.h"
 #include "util_time.h"
 
@@ -7,6 +9,12 @@ namespace dxvk {
 
   /**
    * \brief Utility class for accurate sleeping
+   *
+   * Uses the system's sleep functions for the bulk of the
+   * sleep duration and busy-waits for the remainder. The
+   * busy-wait period is derived from the sleep overshoot
+   * measured at runtime, and can be capped by setting
+   * \c DXVK_SLEEP_SPIN_BUDGET to a value in microseconds.
    */
   class Sleep {
 
@@ -60,8 +68,16 @@ namespace dxvk {
     using TimerDuration = std::chrono::nanoseconds;
 #endif
 
+    constexpr static uint32_t OvershootSampleCount = 64u;
+    constexpr static uint32_t OvershootMinSamples  = 8u;
+
     TimerDuration m_sleepGranularity = TimerDuration::zero();
     TimerDuration m_sleepThreshold   = TimerDuration::zero();
+    TimerDuration m_spinBudget       = TimerDuration::max();
+
+    std::array<TimerDuration, OvershootSampleCount> m_overshootSamples = { };
+    uint32_t      m_overshootSampleCount = 0u;
+    TimerDuration m_overshootEstimate    = TimerDuration::zero();
 
     Sleep();
 
@@ -73,6 +89,10 @@ namespace dxvk {
 
     void systemSleep(TimerDuration duration);
 
+    TimerDuration computeSpinThreshold(TimerDuration duration);
+
+    void recordOvershoot(TimerDuration overshoot);
+
   };
 
 }